@@ -0,0 +1,70 @@
+#!/bin/bash
+# Headless combat benchmark for ProjectXS
+# Runs the -XSBenchmark scenario on a map with the null RHI and fails when
+# the measured frame times, memory or traces regress past the stored baseline,
+# or when the map has no baseline yet
+#
+# Usage: RunBenchmark.sh [Map] [extra arguments]
+#   UE_DIR                    Unreal Engine install (default /opt/UnrealEngine)
+#   XS_BENCHMARK_NPCS         NPCs kept alive during the run
+#   XS_BENCHMARK_BOTS         Ability character bots
+#   XS_BENCHMARK_DURATION     Measured seconds of game time
+#   XS_BENCHMARK_BOT_CLASSES  Comma separated bot class paths, overriding BotClasses in DefaultGame.ini
+#
+# Baselines live next to this script as <Map>_Baseline.json. To record or
+# update one on the benchmark machine, pass -XSBenchmarkWriteBaseline and
+# commit the written file after reviewing it.
+
+echo "====================================="
+echo "ProjectXS Benchmark"
+echo "====================================="
+echo ""
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+UE_DIR="${UE_DIR:-/opt/UnrealEngine}"
+EDITOR="$UE_DIR/Engine/Binaries/Linux/UnrealEditor-Cmd"
+
+MAP="${1:-Lvl_Shooter}"
+shift
+
+if [ ! -f "$EDITOR" ]; then
+    echo "ERROR: UnrealEditor-Cmd not found at: $EDITOR"
+    echo "Set UE_DIR to your Unreal Engine 5.7 install."
+    exit 1
+fi
+
+echo "Running $MAP..."
+echo ""
+
+# -benchmark -fps=30 steps game time in fixed increments so every run plays the same scenario
+"$EDITOR" "$PROJECT_DIR/ProjectXS.uproject" "/Game/Variant_Shooter/$MAP" -game \
+    -nullrhi -unattended -nosplash -nosound -stdout -FullStdOutLogOutput \
+    -benchmark -fps=30 -deterministic \
+    -XSBenchmark \
+    -XSBenchmarkNPCs="${XS_BENCHMARK_NPCS:-24}" \
+    -XSBenchmarkBots="${XS_BENCHMARK_BOTS:-6}" \
+    -XSBenchmarkDuration="${XS_BENCHMARK_DURATION:-60}" \
+    -XSBenchmarkBaseline="$SCRIPT_DIR/${MAP}_Baseline.json" \
+    ${XS_BENCHMARK_BOT_CLASSES:+-XSBenchmarkBotClasses="$XS_BENCHMARK_BOT_CLASSES"} \
+    "$@"
+
+BENCHMARK_RESULT=$?
+
+echo ""
+echo "====================================="
+if [ $BENCHMARK_RESULT -eq 0 ]; then
+    echo "✓ BENCHMARK PASSED"
+elif [ $BENCHMARK_RESULT -eq 2 ]; then
+    echo "✗ NO BASELINE"
+    echo "Record $SCRIPT_DIR/${MAP}_Baseline.json with -XSBenchmarkWriteBaseline."
+elif [ $BENCHMARK_RESULT -eq 3 ]; then
+    echo "✗ PERFORMANCE REGRESSION"
+    echo "See the XSBenchmark lines above for the metrics that regressed."
+else
+    echo "✗ BENCHMARK FAILED ($BENCHMARK_RESULT)"
+fi
+echo "Results: $PROJECT_DIR/Saved/Benchmark"
+echo "====================================="
+
+exit $BENCHMARK_RESULT
@@ -0,0 +1,55 @@
+#!/bin/bash
+# Dedicated server build for ProjectXS
+# Builds, cooks and stages the ProjectXSServer target for Linux. The server target
+# compiles out UI widgets, cosmetic montages and debug drawing.
+#
+# Usage: BuildServer.sh [Configuration]
+#   UE_DIR    Unreal Engine install (default /opt/UnrealEngine)
+#   Configuration defaults to Development
+#
+# The staged server lands in Saved/StagedBuilds/LinuxServer. Run it headless with:
+#   ProjectXSServer.sh /Game/Variant_Shooter/Lvl_Shooter -log -port=7777
+
+echo "====================================="
+echo "ProjectXS Dedicated Server Build"
+echo "====================================="
+echo ""
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+UE_DIR="${UE_DIR:-/opt/UnrealEngine}"
+RUN_UAT="$UE_DIR/Engine/Build/BatchFiles/RunUAT.sh"
+PROJECT="$PROJECT_DIR/ProjectXS.uproject"
+CONFIGURATION="${1:-Development}"
+
+if [ ! -f "$RUN_UAT" ]; then
+    echo "ERROR: RunUAT not found at: $RUN_UAT"
+    echo "Set UE_DIR to a source build of Unreal Engine 5.7, server targets need one."
+    exit 1
+fi
+
+echo "Building ProjectXSServer (Linux $CONFIGURATION)..."
+echo ""
+
+"$RUN_UAT" BuildCookRun \
+    -project="$PROJECT" \
+    -server -noclient \
+    -serverplatform=Linux \
+    -serverconfig="$CONFIGURATION" \
+    -build -cook -stage -pak \
+    -unattended -utf8output
+
+BUILD_RESULT=$?
+
+echo ""
+echo "====================================="
+if [ $BUILD_RESULT -eq 0 ]; then
+    echo "✓ SERVER BUILD SUCCESSFUL!"
+    echo "Staged to $PROJECT_DIR/Saved/StagedBuilds/LinuxServer"
+else
+    echo "✗ SERVER BUILD FAILED"
+    echo "Please check the output above for errors."
+fi
+echo "====================================="
+
+exit $BUILD_RESULT
@@ -0,0 +1,98 @@
+#!/bin/bash
+# Local network soak test for ProjectXS
+# Launches a dedicated server and N headless clients on this machine. Every client is
+# driven by a soak bot that moves, fires every ability and reloads, with simulated
+# packet lag and loss on all connections.
+#
+# Usage: RunSoak.sh [NumClients] [extra arguments]
+#   UE_DIR               Unreal Engine install (default /opt/UnrealEngine)
+#   XS_SOAK_MAP          Map to soak (default /Game/Variant_Shooter/Lvl_Shooter)
+#   XS_SOAK_DURATION     Seconds each client records (default 300)
+#   XS_SOAK_PAWN         Ability character class path for the bots
+#   XS_SOAK_LAG          Simulated lag in ms (default 80)
+#   XS_SOAK_LAG_VARIANCE Simulated lag variance in ms (default 20)
+#   XS_SOAK_LOSS         Simulated packet loss in percent (default 2)
+#   XS_SOAK_PORT         Server port (default 7777)
+#
+# Results land in Saved/Soak: a json summary and a CSV profile per process, plus
+# the server's Networking Insights trace with replication cost per actor class.
+
+echo "====================================="
+echo "ProjectXS Network Soak"
+echo "====================================="
+echo ""
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+UE_DIR="${UE_DIR:-/opt/UnrealEngine}"
+EDITOR="$UE_DIR/Engine/Binaries/Linux/UnrealEditor-Cmd"
+PROJECT="$PROJECT_DIR/ProjectXS.uproject"
+SOAK_DIR="$PROJECT_DIR/Saved/Soak"
+
+NUM_CLIENTS="${1:-8}"
+shift
+
+MAP="${XS_SOAK_MAP:-/Game/Variant_Shooter/Lvl_Shooter}"
+DURATION="${XS_SOAK_DURATION:-300}"
+PORT="${XS_SOAK_PORT:-7777}"
+NET_EMULATION="-PktLag=${XS_SOAK_LAG:-80} -PktLagVariance=${XS_SOAK_LAG_VARIANCE:-20} -PktLoss=${XS_SOAK_LOSS:-2}"
+
+PAWN_ARG=""
+if [ -n "$XS_SOAK_PAWN" ]; then
+    PAWN_ARG="-XSSoakPawn=$XS_SOAK_PAWN"
+fi
+
+if [ ! -f "$EDITOR" ]; then
+    echo "ERROR: UnrealEditor-Cmd not found at: $EDITOR"
+    echo "Set UE_DIR to your Unreal Engine 5.7 install."
+    exit 1
+fi
+
+mkdir -p "$SOAK_DIR"
+
+# the server outlives the clients so it records the whole session
+SERVER_DURATION=$((DURATION + 60))
+
+echo "Starting server on port $PORT..."
+
+"$EDITOR" "$PROJECT" "$MAP?game=/Script/ProjectXS.XSSoakGameMode" -server -port="$PORT" \
+    -unattended -nosound -log -stdout \
+    -XSSoak -XSSoakDuration="$SERVER_DURATION" $PAWN_ARG $NET_EMULATION \
+    -trace=net,cpu,frame -NetTrace=1 -tracefile="$SOAK_DIR/Server.utrace" \
+    "$@" > "$SOAK_DIR/Server.log" 2>&1 &
+SERVER_PID=$!
+
+# give the server time to load the map
+sleep 20
+
+echo "Starting $NUM_CLIENTS clients..."
+
+CLIENT_PIDS=()
+for ((i = 0; i < NUM_CLIENTS; i++)); do
+    "$EDITOR" "$PROJECT" "127.0.0.1:$PORT" -game -nullrhi \
+        -unattended -nosound -nosplash -log -stdout \
+        -XSSoak -XSSoakDuration="$DURATION" -XSSoakSeed="$i" $NET_EMULATION \
+        "$@" > "$SOAK_DIR/Client_$i.log" 2>&1 &
+    CLIENT_PIDS+=($!)
+done
+
+SOAK_RESULT=0
+
+for PID in "${CLIENT_PIDS[@]}"; do
+    wait "$PID" || SOAK_RESULT=1
+done
+
+wait "$SERVER_PID" || SOAK_RESULT=1
+
+echo ""
+echo "====================================="
+if [ $SOAK_RESULT -eq 0 ]; then
+    echo "✓ SOAK COMPLETE"
+else
+    echo "✗ SOAK FAILED"
+    echo "Check the logs in $SOAK_DIR"
+fi
+echo "Results: $SOAK_DIR"
+echo "====================================="
+
+exit $SOAK_RESULT
@@ -10,28 +10,49 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "ProjectXS.h"
 
-AProjectXSCharacter::AProjectXSCharacter()
+const FName AProjectXSCharacter::FirstPersonMeshComponentName(TEXT("First Person Mesh"));
+const FName AProjectXSCharacter::FirstPersonCameraComponentName(TEXT("First Person Camera"));
+
+AProjectXSCharacter::AProjectXSCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
 {
 	// Set size for collision capsule
 	GetCapsuleComponent()->InitCapsuleSize(55.f, 96.0f);
 	
 	// Create the first person mesh that will be viewed only by this character's owner
-	FirstPersonMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("First Person Mesh"));
+	FirstPersonMesh = CreateOptionalDefaultSubobject<USkeletalMeshComponent>(FirstPersonMeshComponentName);
 
-	FirstPersonMesh->SetupAttachment(GetMesh());
-	FirstPersonMesh->SetOnlyOwnerSee(true);
-	FirstPersonMesh->FirstPersonPrimitiveType = EFirstPersonPrimitiveType::FirstPerson;
-	FirstPersonMesh->SetCollisionProfileName(FName("NoCollision"));
+	if (FirstPersonMesh)
+	{
+		FirstPersonMesh->SetupAttachment(GetMesh());
+		FirstPersonMesh->SetOnlyOwnerSee(true);
+		FirstPersonMesh->FirstPersonPrimitiveType = EFirstPersonPrimitiveType::FirstPerson;
+		FirstPersonMesh->SetCollisionProfileName(FName("NoCollision"));
+	}
 
 	// Create the Camera Component	
-	FirstPersonCameraComponent = CreateDefaultSubobject<UCameraComponent>(TEXT("First Person Camera"));
-	FirstPersonCameraComponent->SetupAttachment(FirstPersonMesh, FName("head"));
-	FirstPersonCameraComponent->SetRelativeLocationAndRotation(FVector(-2.8f, 5.89f, 0.0f), FRotator(0.0f, 90.0f, -90.0f));
-	FirstPersonCameraComponent->bUsePawnControlRotation = true;
-	FirstPersonCameraComponent->bEnableFirstPersonFieldOfView = true;
-	FirstPersonCameraComponent->bEnableFirstPersonScale = true;
-	FirstPersonCameraComponent->FirstPersonFieldOfView = 70.0f;
-	FirstPersonCameraComponent->FirstPersonScale = 0.6f;
+	FirstPersonCameraComponent = CreateOptionalDefaultSubobject<UCameraComponent>(FirstPersonCameraComponentName);
+
+	if (FirstPersonCameraComponent)
+	{
+		if (FirstPersonMesh)
+		{
+			FirstPersonCameraComponent->SetupAttachment(FirstPersonMesh, FName("head"));
+			FirstPersonCameraComponent->SetRelativeLocationAndRotation(FVector(-2.8f, 5.89f, 0.0f), FRotator(0.0f, 90.0f, -90.0f));
+		}
+		else
+		{
+			// No first person mesh, so place the camera at eye height
+			FirstPersonCameraComponent->SetupAttachment(GetCapsuleComponent());
+			FirstPersonCameraComponent->SetRelativeLocation(FVector(0.0f, 0.0f, BaseEyeHeight));
+		}
+
+		FirstPersonCameraComponent->bUsePawnControlRotation = true;
+		FirstPersonCameraComponent->bEnableFirstPersonFieldOfView = true;
+		FirstPersonCameraComponent->bEnableFirstPersonScale = true;
+		FirstPersonCameraComponent->FirstPersonFieldOfView = 70.0f;
+		FirstPersonCameraComponent->FirstPersonScale = 0.6f;
+	}
 
 	// configure the character comps
 	GetMesh()->SetOwnerNoSee(true);
@@ -44,6 +65,19 @@ AProjectXSCharacter::AProjectXSCharacter()
 	GetCharacterMovement()->AirControl = 0.5f;
 }
 
+void AProjectXSCharacter::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Nobody sees the first person mesh on a dedicated server, never evaluate its animation there.
+	// The camera stays attached to the reference pose, which is all server side aiming needs
+	if (FirstPersonMesh && GetNetMode() == NM_DedicatedServer)
+	{
+		FirstPersonMesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+		FirstPersonMesh->SetComponentTickEnabled(false);
+	}
+}
+
 void AProjectXSCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {	
 	// Set up action bindings
@@ -50,7 +50,9 @@ protected:
 	class UInputAction* MouseLookAction;
 	
 public:
-	AProjectXSCharacter();
+
+	/** Constructor. Subclasses can skip the first person mesh and camera with DoNotCreateDefaultSubobject */
+	AProjectXSCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
 protected:
 
@@ -78,16 +80,25 @@ protected:
 
 protected:
 
+	/** Gameplay initialization */
+	virtual void BeginPlay() override;
+
 	/** Set up input action bindings */
 	virtual void SetupPlayerInputComponent(UInputComponent* InputComponent) override;
 	
 
 public:
 
-	/** Returns the first person mesh **/
+	/** Name of the optional first person mesh subobject */
+	static const FName FirstPersonMeshComponentName;
+
+	/** Name of the optional first person camera subobject */
+	static const FName FirstPersonCameraComponentName;
+
+	/** Returns the first person mesh. May be null on characters that skip it **/
 	USkeletalMeshComponent* GetFirstPersonMesh() const { return FirstPersonMesh; }
 
-	/** Returns first person camera component **/
+	/** Returns first person camera component. May be null on characters that skip it **/
 	UCameraComponent* GetFirstPersonCameraComponent() const { return FirstPersonCameraComponent; }
 
 };
@@ -12,6 +12,7 @@
 #include "Widgets/Input/SVirtualJoystick.h"
 #include "AbilitySystemComponent.h"
 #include "XSAbilityCharacter.h"
+#include "XSFireLatencySubsystem.h"
 
 AProjectXSPlayerController::AProjectXSPlayerController()
 {
@@ -23,7 +24,7 @@ void AProjectXSPlayerController::BeginPlay()
 {
 	Super::BeginPlay();
 
-	
+#if !UE_SERVER
 	// only spawn touch controls on local player controllers
 	if (ShouldUseTouchControls() && IsLocalPlayerController())
 	{
@@ -42,6 +43,7 @@ void AProjectXSPlayerController::BeginPlay()
 		}
 
 	}
+#endif
 }
 
 void AProjectXSPlayerController::SetupInputComponent()
@@ -136,7 +138,20 @@ void AProjectXSPlayerController::OnFirePressed()
 {
 	if (UAbilitySystemComponent* ASC = GetAbilitySystemComponent())
 	{
+		// Start of the fire latency measurement
+		UXSFireLatencySubsystem* FireLatency = GetWorld()->GetSubsystem<UXSFireLatencySubsystem>();
+		if (FireLatency)
+		{
+			FireLatency->MarkFireInput(ASC);
+		}
+
 		ASC->AbilityLocalInputPressed(3); // Input ID 3 for primary fire
+
+		// Forget the input if it didn't activate the ability
+		if (FireLatency)
+		{
+			FireLatency->ClearFireInput(ASC);
+		}
 	}
 }
 
@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProjectXSStats.h"
+
+DEFINE_STAT(STAT_XS_FireWeapon);
+DEFINE_STAT(STAT_XS_Hitscan);
+DEFINE_STAT(STAT_XS_ApplyDamage);
+DEFINE_STAT(STAT_XS_PostGameplayEffectExecute);
+DEFINE_STAT(STAT_XS_ProjectileHit);
+DEFINE_STAT(STAT_XS_ProjectileExplosion);
+DEFINE_STAT(STAT_XS_LineOfSightCondition);
+DEFINE_STAT(STAT_XS_PerceptionBatch);
+DEFINE_STAT(STAT_XS_SenseEnemies);
+
+DEFINE_STAT(STAT_XS_TracesIssued);
+DEFINE_STAT(STAT_XS_DamageEvents);
+DEFINE_STAT(STAT_XS_AbilitiesActivated);
+DEFINE_STAT(STAT_XS_ProjectilesSpawned);
+DEFINE_STAT(STAT_XS_ProjectilesAlive);
+
+DEFINE_STAT(STAT_XS_Latency_InputToActivate_P50);
+DEFINE_STAT(STAT_XS_Latency_InputToActivate_P95);
+DEFINE_STAT(STAT_XS_Latency_InputToActivate_P99);
+DEFINE_STAT(STAT_XS_Latency_InputToHit_P50);
+DEFINE_STAT(STAT_XS_Latency_InputToHit_P95);
+DEFINE_STAT(STAT_XS_Latency_InputToHit_P99);
+DEFINE_STAT(STAT_XS_Latency_InputToHealth_P50);
+DEFINE_STAT(STAT_XS_Latency_InputToHealth_P95);
+DEFINE_STAT(STAT_XS_Latency_InputToHealth_P99);
+DEFINE_STAT(STAT_XS_Latency_ServerActivateToHit_P50);
+DEFINE_STAT(STAT_XS_Latency_ServerActivateToHit_P95);
+DEFINE_STAT(STAT_XS_Latency_ServerActivateToHit_P99);
+DEFINE_STAT(STAT_XS_Latency_ServerActivateToDamage_P50);
+DEFINE_STAT(STAT_XS_Latency_ServerActivateToDamage_P95);
+DEFINE_STAT(STAT_XS_Latency_ServerActivateToDamage_P99);
+
+uint64 GXSTracesIssued = 0;
+
+UE_TRACE_CHANNEL_DEFINE(XSGameplayChannel);
+
+CSV_DEFINE_CATEGORY_MODULE(PROJECTXS_API, XS, true);
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+// ====== Stat Group ======
+
+/** Gameplay stats. Use "stat XS" in game to display them */
+DECLARE_STATS_GROUP(TEXT("XS Gameplay"), STATGROUP_XS, STATCAT_Advanced);
+
+// ====== Cycle Counters ======
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Fire Weapon"), STAT_XS_FireWeapon, STATGROUP_XS, PROJECTXS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hitscan"), STAT_XS_Hitscan, STATGROUP_XS, PROJECTXS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Damage"), STAT_XS_ApplyDamage, STATGROUP_XS, PROJECTXS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Post Gameplay Effect Execute"), STAT_XS_PostGameplayEffectExecute, STATGROUP_XS, PROJECTXS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Hit"), STAT_XS_ProjectileHit, STATGROUP_XS, PROJECTXS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Explosion"), STAT_XS_ProjectileExplosion, STATGROUP_XS, PROJECTXS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Line of Sight Condition"), STAT_XS_LineOfSightCondition, STATGROUP_XS, PROJECTXS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Perception Batch"), STAT_XS_PerceptionBatch, STATGROUP_XS, PROJECTXS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sense Enemies"), STAT_XS_SenseEnemies, STATGROUP_XS, PROJECTXS_API);
+
+// ====== Counters ======
+
+/** Collision traces issued by gameplay code this frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces Issued"), STAT_XS_TracesIssued, STATGROUP_XS, PROJECTXS_API);
+
+/** Damage applied this frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Damage Events"), STAT_XS_DamageEvents, STATGROUP_XS, PROJECTXS_API);
+
+/** Abilities activated this frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Abilities Activated"), STAT_XS_AbilitiesActivated, STATGROUP_XS, PROJECTXS_API);
+
+/** Projectiles spawned this frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Projectiles Spawned"), STAT_XS_ProjectilesSpawned, STATGROUP_XS, PROJECTXS_API);
+
+/** Projectiles currently alive. Not reset between frames, and not captured to CSV, which only holds per-frame totals */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectiles Alive"), STAT_XS_ProjectilesAlive, STATGROUP_XS, PROJECTXS_API);
+
+// ====== Fire Latency ======
+
+/** Fire pipeline latency percentiles, in milliseconds. Use "stat XSLatency" in game to display them */
+DECLARE_STATS_GROUP(TEXT("XS Fire Latency"), STATGROUP_XSLatency, STATCAT_Advanced);
+
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Input to Activate P50"), STAT_XS_Latency_InputToActivate_P50, STATGROUP_XSLatency, PROJECTXS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Input to Activate P95"), STAT_XS_Latency_InputToActivate_P95, STATGROUP_XSLatency, PROJECTXS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Input to Activate P99"), STAT_XS_Latency_InputToActivate_P99, STATGROUP_XSLatency, PROJECTXS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Input to Hit P50"), STAT_XS_Latency_InputToHit_P50, STATGROUP_XSLatency, PROJECTXS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Input to Hit P95"), STAT_XS_Latency_InputToHit_P95, STATGROUP_XSLatency, PROJECTXS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Input to Hit P99"), STAT_XS_Latency_InputToHit_P99, STATGROUP_XSLatency, PROJECTXS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Input to Health Update P50"), STAT_XS_Latency_InputToHealth_P50, STATGROUP_XSLatency, PROJECTXS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Input to Health Update P95"), STAT_XS_Latency_InputToHealth_P95, STATGROUP_XSLatency, PROJECTXS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Input to Health Update P99"), STAT_XS_Latency_InputToHealth_P99, STATGROUP_XSLatency, PROJECTXS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Server Activate to Hit P50"), STAT_XS_Latency_ServerActivateToHit_P50, STATGROUP_XSLatency, PROJECTXS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Server Activate to Hit P95"), STAT_XS_Latency_ServerActivateToHit_P95, STATGROUP_XSLatency, PROJECTXS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Server Activate to Hit P99"), STAT_XS_Latency_ServerActivateToHit_P99, STATGROUP_XSLatency, PROJECTXS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Server Activate to Damage P50"), STAT_XS_Latency_ServerActivateToDamage_P50, STATGROUP_XSLatency, PROJECTXS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Server Activate to Damage P95"), STAT_XS_Latency_ServerActivateToDamage_P95, STATGROUP_XSLatency, PROJECTXS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Server Activate to Damage P99"), STAT_XS_Latency_ServerActivateToDamage_P99, STATGROUP_XSLatency, PROJECTXS_API);
+
+// ====== Totals ======
+
+/** Collision traces issued by gameplay code since startup. Game thread only, read by the -XSBenchmark runs */
+extern PROJECTXS_API uint64 GXSTracesIssued;
+
+// ====== Trace Channel ======
+
+/** Insights trace channel for gameplay scopes. Enable with -trace=cpu,XSGameplay */
+UE_TRACE_CHANNEL_EXTERN(XSGameplayChannel, PROJECTXS_API);
+
+// ====== CSV Category ======
+
+/** CSV profiler category for the gameplay counters, captured by the -XSBenchmark runs */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(PROJECTXS_API, XS);
+
+// ====== Macros ======
+
+#if !UE_BUILD_SHIPPING
+
+/** Times the enclosing scope with a cycle counter and an Insights event on the gameplay channel */
+#define XS_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(#Stat, XSGameplayChannel)
+
+/** Adds to a counter, and to its per-frame total in CSV captures */
+#define XS_INC_COUNTER(Stat, Amount) \
+	INC_DWORD_STAT_BY(Stat, Amount); \
+	CSV_CUSTOM_STAT(XS, Stat, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate)
+
+
+#else
+
+#define XS_SCOPE_CYCLE_COUNTER(Stat)
+#define XS_INC_COUNTER(Stat, Amount)
+
+#endif
+
+/** Counts collision traces issued by gameplay code, in the per-frame counter and in the running total */
+#define XS_INC_TRACES(Amount) \
+	XS_INC_COUNTER(STAT_XS_TracesIssued, Amount); \
+	GXSTracesIssued += static_cast<uint64>(Amount)
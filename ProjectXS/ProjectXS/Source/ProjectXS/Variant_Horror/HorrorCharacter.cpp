@@ -2,8 +2,7 @@
 
 
 #include "Variant_Horror/HorrorCharacter.h"
-#include "Engine/World.h"
-#include "TimerManager.h"
+#include "XSResourceMeterComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Components/SpotLightComponent.h"
@@ -22,28 +21,33 @@ AHorrorCharacter::AHorrorCharacter()
 	SpotLight->AttenuationRadius = 1050.0f;
 	SpotLight->InnerConeAngle = 18.7f;
 	SpotLight->OuterConeAngle = 45.24f;
+
+	// create the sprint meter
+	SprintMeter = CreateDefaultSubobject<UXSResourceMeterComponent>(TEXT("SprintMeter"));
 }
 
 void AHorrorCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// subscribe to the sprint meter
+	SprintMeter->OnMeterChanged.AddDynamic(this, &AHorrorCharacter::OnSprintMeterChanged);
+	SprintMeter->OnMeterEmptied.AddDynamic(this, &AHorrorCharacter::OnSprintMeterEmptied);
+	SprintMeter->OnMeterFilled.AddDynamic(this, &AHorrorCharacter::OnSprintMeterFilled);
+
 	// initialize sprint meter to max
-	SprintMeter = SprintTime;
+	SprintMeter->InitializeMeter(SprintTime, SprintTime);
 
 	// Initialize the walk speed
 	GetCharacterMovement()->MaxWalkSpeed = WalkSpeed;
-
-	// start the sprint tick timer
-	GetWorld()->GetTimerManager().SetTimer(SprintTimer, this, &AHorrorCharacter::SprintFixedTick, SprintFixedTickTime, true);
 }
 
-void AHorrorCharacter::EndPlay(EEndPlayReason::Type EndPlayReason)
+void AHorrorCharacter::OnMovementUpdated(float DeltaSeconds, FVector OldLocation, FVector OldVelocity)
 {
-	Super::EndPlay(EndPlayReason);
+	Super::OnMovementUpdated(DeltaSeconds, OldLocation, OldVelocity);
 
-	// clear the sprint timer
-	GetWorld()->GetTimerManager().ClearTimer(SprintTimer);
+	// start or stop draining as our speed crosses the walk speed
+	UpdateSprintDrain();
 }
 
 void AHorrorCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -77,6 +81,7 @@ void AHorrorCharacter::DoStartSprint()
 		OnSprintStateChanged.Broadcast(true);
 	}
 
+	UpdateSprintDrain();
 }
 
 void AHorrorCharacter::DoEndSprint()
@@ -93,51 +98,61 @@ void AHorrorCharacter::DoEndSprint()
 		// call the sprint state changed delegate
 		OnSprintStateChanged.Broadcast(false);
 	}
+
+	UpdateSprintDrain();
 }
 
-void AHorrorCharacter::SprintFixedTick()
+void AHorrorCharacter::UpdateSprintDrain()
 {
 	// are we out of recovery, still have stamina and are moving faster than our walk speed?
-	if (bSprinting && !bRecovering && GetVelocity().Length() > WalkSpeed)
+	const bool bShouldDrain = bSprinting && !bRecovering && GetVelocity().Length() > WalkSpeed;
+
+	// only touch the meter when the drain state flips
+	if (bShouldDrain != bDraining)
 	{
+		bDraining = bShouldDrain;
 
-		// do we still have meter to burn?
-		if (SprintMeter > 0.0f)
-		{
-			// update the sprint meter
-			SprintMeter = FMath::Max(SprintMeter - SprintFixedTickTime, 0.0f);
-
-			// have we run out of stamina?
-			if (SprintMeter <= 0.0f)
-			{
-				// raise the recovering flag
-				bRecovering = true;
-
-				// set the recovering walk speed
-				GetCharacterMovement()->MaxWalkSpeed = RecoveringWalkSpeed;
-			}
-		}
-		
-	} else {
+		// burn or recover one second of stamina per second
+		SprintMeter->SetRate(bDraining ? -1.0f : 1.0f);
+	}
+}
 
-		// recover stamina
-		SprintMeter = FMath::Min(SprintMeter + SprintFixedTickTime, SprintTime);
+void AHorrorCharacter::OnSprintMeterChanged(float Value, float Rate)
+{
+	// broadcast the sprint meter updated delegate
+	OnSprintMeterUpdated.Broadcast(SprintMeter->GetPercent());
+}
 
-		if (SprintMeter >= SprintTime)
-		{
-			// lower the recovering flag
-			bRecovering = false;
+void AHorrorCharacter::OnSprintMeterEmptied(UXSResourceMeterComponent* Meter)
+{
+	// raise the recovering flag
+	bRecovering = true;
+	bDraining = false;
 
-			// set the walk or sprint speed depending on whether the sprint button is down
-			GetCharacterMovement()->MaxWalkSpeed = bSprinting ? SprintSpeed : WalkSpeed;
+	// set the recovering walk speed
+	GetCharacterMovement()->MaxWalkSpeed = RecoveringWalkSpeed;
 
-			// update the sprint state depending on whether the button is down or not
-			OnSprintStateChanged.Broadcast(bSprinting);
-		}
+	// start recovering stamina
+	SprintMeter->SetRate(1.0f);
+}
 
+void AHorrorCharacter::OnSprintMeterFilled(UXSResourceMeterComponent* Meter)
+{
+	// nothing to do if we topped up without running out
+	if (!bRecovering)
+	{
+		return;
 	}
 
-	// broadcast the sprint meter updated delegate
-	OnSprintMeterUpdated.Broadcast(SprintMeter / SprintTime);
+	// lower the recovering flag
+	bRecovering = false;
+
+	// set the walk or sprint speed depending on whether the sprint button is down
+	GetCharacterMovement()->MaxWalkSpeed = bSprinting ? SprintSpeed : WalkSpeed;
+
+	// update the sprint state depending on whether the button is down or not
+	OnSprintStateChanged.Broadcast(bSprinting);
 
+	// resume draining if we're still sprinting
+	UpdateSprintDrain();
 }
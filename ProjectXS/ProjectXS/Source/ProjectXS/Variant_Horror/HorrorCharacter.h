@@ -7,6 +7,7 @@
 #include "HorrorCharacter.generated.h"
 
 class USpotLightComponent;
+class UXSResourceMeterComponent;
 class UInputAction;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FUpdateSprintMeterDelegate, float, Percentage);
@@ -15,6 +16,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSprintStateChangedDelegate, bool, b
 /**
  *  Simple first person horror character
  *  Provides stamina-based sprinting
+ *  The sprint meter is evaluated on demand and only raises events when it starts or stops
+ *  changing, so an idle character does no sprint work at all
  */
 UCLASS(abstract)
 class PROJECTXS_API AHorrorCharacter : public AProjectXSCharacter
@@ -24,6 +27,10 @@ class PROJECTXS_API AHorrorCharacter : public AProjectXSCharacter
 	/** Player light source */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	USpotLightComponent* SpotLight;
+
+	/** Sprint stamina meter. Maxes at SprintTime */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UXSResourceMeterComponent* SprintMeter;
 	
 protected:
 
@@ -37,17 +44,13 @@ protected:
 	/** If true, we're recovering stamina */
 	bool bRecovering = false;
 
+	/** If true, the sprint meter is draining */
+	bool bDraining = false;
+
 	/** Default walk speed when not sprinting or recovering */
 	UPROPERTY(EditAnywhere, Category="Walk")
 	float WalkSpeed = 250.0f;
 
-	/** Time interval for sprinting stamina ticks */
-	UPROPERTY(EditAnywhere, Category="Sprint", meta = (ClampMin = 0, ClampMax = 1, Units = "s"))
-	float SprintFixedTickTime = 0.03333f;
-
-	/** Sprint stamina amount. Maxes at SprintTime */
-	float SprintMeter = 0.0f;
-
 	/** How long we can sprint for, in seconds */
 	UPROPERTY(EditAnywhere, Category="Sprint", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
 	float SprintTime = 3.0f;
@@ -64,9 +67,6 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Recovery", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
 	float RecoveryTime = 0.0f;
 
-	/** Sprint tick timer */
-	FTimerHandle SprintTimer;
-
 public:
 
 	/** Delegate called when the sprint meter should be updated */
@@ -75,6 +75,9 @@ public:
 	/** Delegate called when we start and stop sprinting */
 	FSprintStateChangedDelegate OnSprintStateChanged;
 
+	/** Returns the sprint stamina meter */
+	UXSResourceMeterComponent* GetSprintMeter() const { return SprintMeter; }
+
 protected:
 
 	/** Constructor */
@@ -83,8 +86,8 @@ protected:
 	/** Gameplay initialization */
 	virtual void BeginPlay() override;
 
-	/** Gameplay cleanup */
-	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+	/** Checks whether the sprint meter should drain after every movement update */
+	virtual void OnMovementUpdated(float DeltaSeconds, FVector OldLocation, FVector OldVelocity) override;
 
 	/** Set up input action bindings */
 	virtual void SetupPlayerInputComponent(UInputComponent* InputComponent) override;
@@ -99,6 +102,18 @@ protected:
 	UFUNCTION(BlueprintCallable, Category="Input")
 	void DoEndSprint();
 
-	/** Called while sprinting at a fixed time interval */
-	void SprintFixedTick();
+	/** Drains or recovers the sprint meter depending on the sprint input and our speed */
+	void UpdateSprintDrain();
+
+	/** Called when the sprint meter value or rate changes */
+	UFUNCTION()
+	void OnSprintMeterChanged(float Value, float Rate);
+
+	/** Called when the sprint meter runs out */
+	UFUNCTION()
+	void OnSprintMeterEmptied(UXSResourceMeterComponent* Meter);
+
+	/** Called when the sprint meter is full again */
+	UFUNCTION()
+	void OnSprintMeterFilled(UXSResourceMeterComponent* Meter);
 };
@@ -21,6 +21,7 @@ void AHorrorPlayerController::BeginPlay()
 {
 	Super::BeginPlay();
 
+#if !UE_SERVER
 	// only spawn touch controls on local player controllers
 	if (ShouldUseTouchControls() && IsLocalPlayerController())
 	{
@@ -39,12 +40,14 @@ void AHorrorPlayerController::BeginPlay()
 		}
 
 	}
+#endif
 }
 
 void AHorrorPlayerController::OnPossess(APawn* aPawn)
 {
 	Super::OnPossess(aPawn);
 
+#if !UE_SERVER
 	// only spawn UI on local player controllers
 	if (IsLocalPlayerController())
 	{
@@ -61,7 +64,7 @@ void AHorrorPlayerController::OnPossess(APawn* aPawn)
 			HorrorUI->SetupCharacter(HorrorCharacter);
 		}
 	}
-	
+#endif
 }
 
 void AHorrorPlayerController::SetupInputComponent()
@@ -3,17 +3,71 @@
 
 #include "HorrorUI.h"
 #include "HorrorCharacter.h"
+#include "XSResourceMeterComponent.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/InvalidationBox.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+void UHorrorUI::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	// cache the HUD's draw data. Only sprint meter pushes invalidate it
+	if (WidgetTree && WidgetTree->RootWidget && !WidgetTree->RootWidget->IsA<UInvalidationBox>())
+	{
+		UInvalidationBox* InvalidationBox = WidgetTree->ConstructWidget<UInvalidationBox>(UInvalidationBox::StaticClass(), TEXT("HorrorUIInvalidationBox"));
+		InvalidationBox->SetContent(WidgetTree->RootWidget);
+		WidgetTree->RootWidget = InvalidationBox;
+	}
+}
 
 void UHorrorUI::SetupCharacter(AHorrorCharacter* HorrorCharacter)
 {
+	SprintMeter = HorrorCharacter->GetSprintMeter();
+
 	HorrorCharacter->OnSprintMeterUpdated.AddDynamic(this, &UHorrorUI::OnSprintMeterUpdated);
 	HorrorCharacter->OnSprintStateChanged.AddDynamic(this, &UHorrorUI::OnSprintStateChanged);
 }
 
 void UHorrorUI::OnSprintMeterUpdated(float Percent)
 {
-	// call the BP handler
-	BP_SprintMeterUpdated(Percent);
+	SprintMeterPercent = Percent;
+
+	// only call the BP handler once per frame
+	UWorld* World = GetWorld();
+
+	if (!bSprintMeterFlushPending && World)
+	{
+		bSprintMeterFlushPending = true;
+		World->GetTimerManager().SetTimerForNextTick(this, &UHorrorUI::FlushSprintMeter);
+	}
+}
+
+void UHorrorUI::FlushSprintMeter()
+{
+	bSprintMeterFlushPending = false;
+
+	// the meter only raises events when it starts or stops changing, sample it in between
+	if (SprintMeter.IsValid())
+	{
+		SprintMeterPercent = SprintMeter->GetPercent();
+
+		// keep sampling next frame while the meter moves
+		if (SprintMeter->IsChanging())
+		{
+			OnSprintMeterUpdated(SprintMeterPercent);
+		}
+	}
+
+	// skip values Blueprint already shows
+	if (SprintMeterPercent != ShownSprintMeterPercent)
+	{
+		ShownSprintMeterPercent = SprintMeterPercent;
+
+		// call the BP handler
+		BP_SprintMeterUpdated(SprintMeterPercent);
+	}
 }
 
 void UHorrorUI::OnSprintStateChanged(bool bSprinting)
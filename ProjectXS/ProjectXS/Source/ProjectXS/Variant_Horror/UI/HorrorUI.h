@@ -7,10 +7,14 @@
 #include "HorrorUI.generated.h"
 
 class AHorrorCharacter;
+class UXSResourceMeterComponent;
 
 /**
  *  Simple UI for a first person horror game
  *  Manages character sprint meter display
+ *  The sprint meter is pushed to Blueprint at most once per frame while it fills or drains,
+ *  and not at all while it is idle. The widget tree is wrapped in an invalidation box,
+ *  so an idle meter costs nothing to paint
  */
 UCLASS(abstract)
 class PROJECTXS_API UHorrorUI : public UUserWidget
@@ -32,6 +36,24 @@ public:
 
 protected:
 
+	/** Wraps the widget tree in an invalidation box */
+	virtual void NativeOnInitialized() override;
+
+	/** Sprint meter of the character being displayed */
+	TWeakObjectPtr<UXSResourceMeterComponent> SprintMeter;
+
+	/** Latest sprint meter percent */
+	float SprintMeterPercent = 1.0f;
+
+	/** Sprint meter percent Blueprint currently shows. Negative forces the first push */
+	float ShownSprintMeterPercent = -1.0f;
+
+	/** True if a sprint meter flush is scheduled for the next tick */
+	bool bSprintMeterFlushPending = false;
+
+	/** Pushes the latest sprint meter percent to Blueprint */
+	void FlushSprintMeter();
+
 	/** Passes control to Blueprint to update the sprint meter widgets */
 	UFUNCTION(BlueprintImplementableEvent, Category="Horror", meta = (DisplayName = "Sprint Meter Updated"))
 	void BP_SprintMeterUpdated(float Percent);
@@ -2,7 +2,6 @@
 
 
 #include "Variant_Shooter/AI/EnvQueryContext_Target.h"
-#include "EnvironmentQuery/Items/EnvQueryItemType_Actor.h"
 #include "EnvironmentQuery/EnvQueryTypes.h"
 #include "ShooterAIController.h"
 
@@ -11,17 +10,8 @@ void UEnvQueryContext_Target::ProvideContext(FEnvQueryInstance& QueryInstance, F
 	// get the controller from the query instance
 	if (AShooterAIController* Controller = Cast<AShooterAIController>(QueryInstance.Owner))
 	{
-		// ensure the target is valid
-		if (IsValid(Controller->GetCurrentTarget()))
-		{
-			// add the controller's target actor to the context
-			UEnvQueryItemType_Actor::SetContextHelper(ContextData, Controller->GetCurrentTarget());
-
-		} else {
-
-			// if for any reason there's no target, default to the controller
-			UEnvQueryItemType_Actor::SetContextHelper(ContextData, Controller);
-		}
+		// add the controller's target actor to the context, shared by every query it runs this frame
+		Controller->GetTargetQueryContext(ContextData);
 	}
 
 }
@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "Variant_Shooter/AI/EnvQueryGenerator_ShooterCover.h"
+#include "EnvironmentQuery/Items/EnvQueryItemType_Point.h"
+#include "EnvironmentQuery/Contexts/EnvQueryContext_Querier.h"
+#include "ShooterCoverSubsystem.h"
+#include "ShooterCoverDatabase.h"
+#include "Engine/World.h"
+#include "Algo/Unique.h"
+
+UEnvQueryGenerator_ShooterCover::UEnvQueryGenerator_ShooterCover()
+{
+	ItemType = UEnvQueryItemType_Point::StaticClass();
+	SearchCenter = UEnvQueryContext_Querier::StaticClass();
+	SearchRadius.DefaultValue = 1500.0f;
+}
+
+void UEnvQueryGenerator_ShooterCover::GenerateItems(FEnvQueryInstance& QueryInstance) const
+{
+	UObject* QueryOwner = QueryInstance.Owner.Get();
+
+	if (!QueryOwner)
+	{
+		return;
+	}
+
+	// get the cover database for this level
+	const UShooterCoverSubsystem* CoverSubsystem = QueryOwner->GetWorld() ? QueryOwner->GetWorld()->GetSubsystem<UShooterCoverSubsystem>() : nullptr;
+	const UShooterCoverDatabase* CoverDatabase = CoverSubsystem ? CoverSubsystem->GetCoverDatabase() : nullptr;
+
+	if (!CoverDatabase)
+	{
+		return;
+	}
+
+	SearchRadius.BindData(QueryOwner, QueryInstance.QueryID);
+	const float Radius = SearchRadius.GetValue();
+
+	TArray<FVector> CenterLocations;
+	QueryInstance.PrepareContext(SearchCenter, CenterLocations);
+
+	// gather the points around every center
+	TArray<int32> PointIndices;
+
+	for (const FVector& CenterLocation : CenterLocations)
+	{
+		CoverDatabase->GatherPointsInRadius(CenterLocation, Radius, PointIndices);
+	}
+
+	// remove the points found from more than one center
+	if (CenterLocations.Num() > 1)
+	{
+		PointIndices.Sort();
+		PointIndices.SetNum(Algo::Unique(PointIndices));
+	}
+
+	for (const int32 PointIndex : PointIndices)
+	{
+		if (!bHighCoverOnly || CoverDatabase->GetPoint(PointIndex).bHighCover)
+		{
+			QueryInstance.AddItemData<UEnvQueryItemType_Point>(CoverDatabase->GetPointLocation(PointIndex));
+		}
+	}
+}
+
+FText UEnvQueryGenerator_ShooterCover::GetDescriptionTitle() const
+{
+	return FText::FromString(FString::Printf(TEXT("Shooter Cover Points around %s"), *UEnvQueryTypes::DescribeContext(SearchCenter).ToString()));
+}
+
+FText UEnvQueryGenerator_ShooterCover::GetDescriptionDetails() const
+{
+	return FText::FromString(FString::Printf(TEXT("radius: %s%s"), *SearchRadius.ToString(), bHighCoverOnly ? TEXT(", high cover only") : TEXT("")));
+}
@@ -0,0 +1,46 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnvironmentQuery/EnvQueryGenerator.h"
+#include "DataProviders/AIDataProvider.h"
+#include "EnvQueryGenerator_ShooterCover.generated.h"
+
+class UEnvQueryContext;
+
+/**
+ *  Custom EnvQuery Generator that returns the baked cover points around a context
+ *  Reads from the level's cover database, so it doesn't need any traces
+ */
+UCLASS(meta=(DisplayName="Shooter Cover Points"))
+class PROJECTXS_API UEnvQueryGenerator_ShooterCover : public UEnvQueryGenerator
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Context to search around */
+	UPROPERTY(EditDefaultsOnly, Category="Generator")
+	TSubclassOf<UEnvQueryContext> SearchCenter;
+
+	/** Radius to search for cover points in */
+	UPROPERTY(EditDefaultsOnly, Category="Generator")
+	FAIDataProviderFloatValue SearchRadius;
+
+	/** If true, only points covering a standing character are returned */
+	UPROPERTY(EditDefaultsOnly, Category="Generator")
+	bool bHighCoverOnly = false;
+
+public:
+
+	/** Constructor */
+	UEnvQueryGenerator_ShooterCover();
+
+	/** Generates the cover point items */
+	virtual void GenerateItems(FEnvQueryInstance& QueryInstance) const override;
+
+	/** Provides the description strings */
+	virtual FText GetDescriptionTitle() const override;
+	virtual FText GetDescriptionDetails() const override;
+};
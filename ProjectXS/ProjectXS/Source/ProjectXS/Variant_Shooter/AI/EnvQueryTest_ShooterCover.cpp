@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "Variant_Shooter/AI/EnvQueryTest_ShooterCover.h"
+#include "EnvironmentQuery/Items/EnvQueryItemType_VectorBase.h"
+#include "EnvQueryContext_Target.h"
+#include "ShooterCoverSubsystem.h"
+#include "ShooterCoverDatabase.h"
+#include "Engine/World.h"
+
+UEnvQueryTest_ShooterCover::UEnvQueryTest_ShooterCover()
+{
+	Cost = EEnvTestCost::Low;
+	ValidItemType = UEnvQueryItemType_VectorBase::StaticClass();
+	SetWorkOnFloatValues(false);
+
+	Threat = UEnvQueryContext_Target::StaticClass();
+}
+
+void UEnvQueryTest_ShooterCover::RunTest(FEnvQueryInstance& QueryInstance) const
+{
+	UObject* QueryOwner = QueryInstance.Owner.Get();
+
+	if (!QueryOwner)
+	{
+		return;
+	}
+
+	// get the cover database for this level
+	const UShooterCoverSubsystem* CoverSubsystem = QueryOwner->GetWorld() ? QueryOwner->GetWorld()->GetSubsystem<UShooterCoverSubsystem>() : nullptr;
+	const UShooterCoverDatabase* CoverDatabase = CoverSubsystem ? CoverSubsystem->GetCoverDatabase() : nullptr;
+
+	if (!CoverDatabase)
+	{
+		return;
+	}
+
+	BoolValue.BindData(QueryOwner, QueryInstance.QueryID);
+	const bool bWantsCover = BoolValue.GetValue();
+
+	TArray<FVector> ThreatLocations;
+
+	if (!QueryInstance.PrepareContext(Threat, ThreatLocations))
+	{
+		return;
+	}
+
+	const float CoverConeDot = FMath::Cos(FMath::DegreesToRadians(CoverConeAngle));
+
+	for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
+	{
+		// find the baked point for this item
+		const int32 PointIndex = CoverDatabase->FindPointAt(GetItemLocation(QueryInstance, It.GetIndex()), PointTolerance);
+
+		bool bCovered = PointIndex != INDEX_NONE && (!bRequireHighCover || CoverDatabase->GetPoint(PointIndex).bHighCover);
+
+		// the point must cover from every threat
+		for (int32 i = 0; i < ThreatLocations.Num() && bCovered; ++i)
+		{
+			bCovered = CoverDatabase->IsCoveredFrom(PointIndex, ThreatLocations[i], CoverConeDot);
+		}
+
+		It.SetScore(TestPurpose, FilterType, bCovered, bWantsCover);
+	}
+}
+
+FText UEnvQueryTest_ShooterCover::GetDescriptionTitle() const
+{
+	return FText::FromString(FString::Printf(TEXT("%s: covered from %s"), *Super::GetDescriptionTitle().ToString(), *UEnvQueryTypes::DescribeContext(Threat).ToString()));
+}
+
+FText UEnvQueryTest_ShooterCover::GetDescriptionDetails() const
+{
+	return DescribeBoolTestParams(TEXT("in cover"));
+}
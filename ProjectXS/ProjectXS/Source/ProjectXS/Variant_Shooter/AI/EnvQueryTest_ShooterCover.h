@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnvironmentQuery/EnvQueryTest.h"
+#include "EnvQueryTest_ShooterCover.generated.h"
+
+class UEnvQueryContext;
+
+/**
+ *  Custom EnvQuery Test that checks if items are in cover from a context
+ *  Uses the level's baked cover directions and cluster visibility instead of tracing
+ */
+UCLASS(meta=(DisplayName="Shooter Cover"))
+class PROJECTXS_API UEnvQueryTest_ShooterCover : public UEnvQueryTest
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Context to take cover from */
+	UPROPERTY(EditDefaultsOnly, Category="Cover")
+	TSubclassOf<UEnvQueryContext> Threat;
+
+	/** Max angle between the cover direction and the threat, in degrees */
+	UPROPERTY(EditDefaultsOnly, Category="Cover", meta=(ClampMin=0, ClampMax=180))
+	float CoverConeAngle = 60.0f;
+
+	/** If true, only points covering a standing character pass */
+	UPROPERTY(EditDefaultsOnly, Category="Cover")
+	bool bRequireHighCover = false;
+
+	/** Max distance between an item and its baked cover point */
+	UPROPERTY(EditDefaultsOnly, Category="Cover")
+	float PointTolerance = 10.0f;
+
+public:
+
+	/** Constructor */
+	UEnvQueryTest_ShooterCover();
+
+	/** Runs the test */
+	virtual void RunTest(FEnvQueryInstance& QueryInstance) const override;
+
+	/** Provides the description strings */
+	virtual FText GetDescriptionTitle() const override;
+	virtual FText GetDescriptionDetails() const override;
+};
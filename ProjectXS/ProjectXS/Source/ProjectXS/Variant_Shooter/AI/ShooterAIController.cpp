@@ -7,6 +7,11 @@
 #include "Perception/AIPerceptionComponent.h"
 #include "Navigation/PathFollowingComponent.h"
 #include "AI/Navigation/PathFollowingAgentInterface.h"
+#include "ShooterSquadKnowledgeSubsystem.h"
+#include "EnvironmentQuery/Items/EnvQueryItemType_Actor.h"
+#include "Engine/World.h"
+#include "WorldCollision.h"
+#include "ProjectXSStats.h"
 
 AShooterAIController::AShooterAIController()
 {
@@ -29,17 +34,50 @@ void AShooterAIController::OnPossess(APawn* InPawn)
 	// ensure we're possessing an NPC
 	if (AShooterNPC* NPC = Cast<AShooterNPC>(InPawn))
 	{
+		// resume ticking if we were kept dormant by the NPC pool
+		SetActorTickEnabled(true);
+
 		// add the team tag to the pawn
-		NPC->Tags.Add(TeamTag);
+		NPC->Tags.AddUnique(TeamTag);
 
 		// subscribe to the pawn's OnDeath delegate
-		NPC->OnPawnDeath.AddDynamic(this, &AShooterAIController::OnPawnDeath);
+		NPC->OnPawnDeath.AddUniqueDynamic(this, &AShooterAIController::OnPawnDeath);
 
 		// start AI logic
 		StateTreeAI->StartLogic();
 	}
 }
 
+void AShooterAIController::EnterDormantState()
+{
+	// stop movement
+	StopMovement();
+
+	// stop StateTree logic
+	StateTreeAI->StopLogic(FString("Dormant"));
+
+	// drop any buffered perception and stop delivering batches
+	ClearPerceptionEvents();
+	SetActorTickEnabled(false);
+}
+
+void AShooterAIController::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// deliver the in flight batch once all its traces are back
+	if (!InFlightPerceptionEvents.IsEmpty() && NumPendingPerceptionTraces == 0)
+	{
+		DeliverPerceptionBatch();
+	}
+
+	// start a new batch with everything perceived since the last one
+	if (InFlightPerceptionEvents.IsEmpty() && !PendingPerceptionEvents.IsEmpty())
+	{
+		StartPerceptionBatch();
+	}
+}
+
 void AShooterAIController::OnPawnDeath()
 {
 	// stop movement
@@ -48,6 +86,28 @@ void AShooterAIController::OnPawnDeath()
 	// stop StateTree logic
 	StateTreeAI->StopLogic(FString(""));
 
+	// clear the target
+	ClearCurrentTarget();
+
+	// drop any buffered perception
+	ClearPerceptionEvents();
+
+	// pooled NPCs keep their controller so both can be recycled together
+	AShooterNPC* NPC = Cast<AShooterNPC>(GetPawn());
+
+	if (NPC && NPC->IsPooled())
+	{
+		// forget everything we've perceived so far
+		AIPerception->ForgetAll();
+
+		NPC->SetDormantController(this);
+
+		// unpossess the pawn
+		UnPossess();
+
+		return;
+	}
+
 	// unpossess the pawn
 	UnPossess();
 
@@ -58,21 +118,179 @@ void AShooterAIController::OnPawnDeath()
 void AShooterAIController::SetCurrentTarget(AActor* Target)
 {
 	TargetEnemy = Target;
+
+	// rebuild the EQS context on the next query
+	TargetQueryContextFrame = 0;
 }
 
 void AShooterAIController::ClearCurrentTarget()
 {
 	TargetEnemy = nullptr;
+
+	// rebuild the EQS context on the next query
+	TargetQueryContextFrame = 0;
+}
+
+void AShooterAIController::GetTargetQueryContext(FEnvQueryContextData& OutContextData)
+{
+	// build the context once per frame. Target changes invalidate it right away
+	if (TargetQueryContextFrame != GFrameCounter)
+	{
+		TargetQueryContextFrame = GFrameCounter;
+
+		// if for any reason there's no target, default to the controller
+		UEnvQueryItemType_Actor::SetContextHelper(TargetQueryContext, IsValid(TargetEnemy) ? TargetEnemy.Get() : this);
+	}
+
+	OutContextData = TargetQueryContext;
+}
+
+void AShooterAIController::AddLineOfSightFilter(const FShooterLineOfSightFilter& Filter)
+{
+	LineOfSightFilters.Add(Filter);
+}
+
+void AShooterAIController::RemoveLineOfSightFilter(const FShooterLineOfSightFilter& Filter)
+{
+	LineOfSightFilters.RemoveSingleSwap(Filter, EAllowShrinking::No);
 }
 
 void AShooterAIController::OnPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
 {
-	// pass the data to the StateTree delegate hook
-	OnShooterPerceptionUpdated.ExecuteIfBound(Actor, Stimulus);
+	FShooterPerceptionEvent& Event = FindOrAddPendingEvent(Actor);
+
+	// keep the strongest stimulus for the actor this frame
+	if (Event.bForgotten || Stimulus.Strength >= Event.Stimulus.Strength)
+	{
+		Event.Stimulus = Stimulus;
+		Event.bForgotten = false;
+	}
 }
 
 void AShooterAIController::OnPerceptionForgotten(AActor* Actor)
 {
+	// forgetting the actor supersedes anything perceived this frame
+	FShooterPerceptionEvent& Event = FindOrAddPendingEvent(Actor);
+	Event.Stimulus = FAIStimulus();
+	Event.bForgotten = true;
+}
+
+FShooterPerceptionEvent& AShooterAIController::FindOrAddPendingEvent(AActor* Actor)
+{
+	if (FShooterPerceptionEvent* Event = PendingPerceptionEvents.FindByPredicate([Actor](const FShooterPerceptionEvent& Pending) { return Pending.Actor == Actor; }))
+	{
+		return *Event;
+	}
+
+	FShooterPerceptionEvent& Event = PendingPerceptionEvents.AddDefaulted_GetRef();
+	Event.Actor = Actor;
+	return Event;
+}
+
+void AShooterAIController::StartPerceptionBatch()
+{
+	XS_SCOPE_CYCLE_COUNTER(STAT_XS_PerceptionBatch);
+
+	InFlightPerceptionEvents = MoveTemp(PendingPerceptionEvents);
+	PendingPerceptionEvents.Reset();
+
+	const APawn* ControlledPawn = GetPawn();
+	const AShooterNPC* NPC = Cast<AShooterNPC>(ControlledPawn);
+	UShooterSquadKnowledgeSubsystem* SquadKnowledge = GetWorld()->GetSubsystem<UShooterSquadKnowledgeSubsystem>();
+
+	for (int32 i = 0; i < InFlightPerceptionEvents.Num(); ++i)
+	{
+		FShooterPerceptionEvent& Event = InFlightPerceptionEvents[i];
+		const AActor* Actor = Event.Actor.Get();
+
+		// skip forgotten actors
+		if (Event.bForgotten || !Actor || !ControlledPawn)
+		{
+			continue;
+		}
+
+		// only trace actors that some listener would take as a direct sighting, with its own tag and cone
+		const FVector PawnLocation = ControlledPawn->GetActorLocation();
+		const FVector StimulusDir = (Event.Stimulus.StimulusLocation - PawnLocation).GetSafeNormal();
+		const float StimulusDot = FVector::DotProduct(StimulusDir, ControlledPawn->GetActorForwardVector());
+
+		const bool bWantsLineOfSight = LineOfSightFilters.ContainsByPredicate([Actor, StimulusDot](const FShooterLineOfSightFilter& Filter)
+		{
+			return StimulusDot >= FMath::Cos(FMath::DegreesToRadians(Filter.ConeHalfAngle)) && Actor->ActorHasTag(Filter.SenseTag);
+		});
+
+		if (!bWantsLineOfSight)
+		{
+			continue;
+		}
+
+		// a teammate looking from almost our eyes just confirmed this actor, so reuse their trace
+		const FVector EyeLocation = ControlledPawn->GetPawnViewLocation();
+
+		if (NPC && SquadKnowledge && SquadKnowledge->CanSkipLineOfSight(NPC->GetTeamByte(), Actor, EyeLocation))
+		{
+			Event.bHasLineOfSight = true;
+			continue;
+		}
+
+		// batch the trace with the rest of the async traces for this frame
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ShooterPerceptionLOS), false);
+		QueryParams.AddIgnoredActor(ControlledPawn);
+		QueryParams.AddIgnoredActor(Actor);
+
+		FTraceDelegate TraceDelegate = FTraceDelegate::CreateUObject(this, &AShooterAIController::OnPerceptionTraceDone, PerceptionBatchSerial, i);
+		GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, EyeLocation, Actor->GetActorLocation(), ECC_Visibility, QueryParams, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate);
+
+		++NumPendingPerceptionTraces;
+		XS_INC_TRACES(1);
+	}
+
+	// nothing to wait for, deliver right away
+	if (NumPendingPerceptionTraces == 0)
+	{
+		DeliverPerceptionBatch();
+	}
+}
+
+void AShooterAIController::DeliverPerceptionBatch()
+{
+	TArray<FShooterPerceptionEvent> Batch = MoveTemp(InFlightPerceptionEvents);
+	InFlightPerceptionEvents.Reset();
+
 	// pass the data to the StateTree delegate hook
-	OnShooterPerceptionForgotten.ExecuteIfBound(Actor);
+	OnShooterPerceptionEvents.Broadcast(Batch);
+}
+
+void AShooterAIController::ClearPerceptionEvents()
+{
+	PendingPerceptionEvents.Reset();
+	InFlightPerceptionEvents.Reset();
+	NumPendingPerceptionTraces = 0;
+
+	// ignore any traces still in flight
+	++PerceptionBatchSerial;
+}
+
+void AShooterAIController::OnPerceptionTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, uint32 BatchSerial, int32 EventIndex)
+{
+	// the batch was discarded
+	if (BatchSerial != PerceptionBatchSerial || !InFlightPerceptionEvents.IsValidIndex(EventIndex))
+	{
+		return;
+	}
+
+	--NumPendingPerceptionTraces;
+
+	// we have direct line of sight if the trace is unobstructed
+	FShooterPerceptionEvent& Event = InFlightPerceptionEvents[EventIndex];
+	Event.bHasLineOfSight = !TraceDatum.OutHits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+
+	// share the confirmed sighting with the squad
+	const AShooterNPC* NPC = Cast<AShooterNPC>(GetPawn());
+	UShooterSquadKnowledgeSubsystem* SquadKnowledge = GetWorld()->GetSubsystem<UShooterSquadKnowledgeSubsystem>();
+
+	if (Event.bHasLineOfSight && NPC && SquadKnowledge)
+	{
+		SquadKnowledge->ReportSighting(NPC->GetTeamByte(), Event.Actor.Get(), TraceDatum.Start);
+	}
 }
@@ -4,14 +4,51 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "Perception/AIPerceptionTypes.h"
+#include "EnvironmentQuery/EnvQueryTypes.h"
 #include "ShooterAIController.generated.h"
 
 class UStateTreeAIComponent;
 class UAIPerceptionComponent;
-struct FAIStimulus;
+struct FTraceHandle;
+struct FTraceDatum;
 
-DECLARE_DELEGATE_TwoParams(FShooterPerceptionUpdatedDelegate, AActor*, const FAIStimulus&);
-DECLARE_DELEGATE_OneParam(FShooterPerceptionForgottenDelegate, AActor*);
+/**
+ *  Buffered perception event, delivered to the StateTree tasks in batches
+ */
+struct FShooterPerceptionEvent
+{
+	/** Perceived actor */
+	TWeakObjectPtr<AActor> Actor;
+
+	/** Latest stimulus for the actor this frame */
+	FAIStimulus Stimulus;
+
+	/** True if the actor was forgotten instead of perceived */
+	bool bForgotten = false;
+
+	/** True if the NPC has direct line of sight to the actor */
+	bool bHasLineOfSight = false;
+};
+
+/**
+ *  Actors a perception listener accepts as direct sightings. Line of sight is only traced for these
+ */
+struct FShooterLineOfSightFilter
+{
+	/** Tag required on the sensed actor */
+	FName SenseTag;
+
+	/** Cone half angle around the pawn's facing the stimulus must be in, in degrees */
+	float ConeHalfAngle = 0.0f;
+
+	bool operator==(const FShooterLineOfSightFilter& Other) const
+	{
+		return SenseTag == Other.SenseTag && ConeHalfAngle == Other.ConeHalfAngle;
+	}
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FShooterPerceptionEventsDelegate, const TArray<FShooterPerceptionEvent>&);
 
 /**
  *  Simple AI Controller for a first person shooter enemy
@@ -38,13 +75,37 @@ protected:
 	/** Enemy currently being targeted */
 	TObjectPtr<AActor> TargetEnemy;
 
+	/** EQS context for the targeted enemy, shared by every query in the frame it was built */
+	FEnvQueryContextData TargetQueryContext;
+
+	/** Frame the target EQS context was built in */
+	uint64 TargetQueryContextFrame = 0;
+
+	/** Filters of the current perception listeners, one entry per listener */
+	TArray<FShooterLineOfSightFilter> LineOfSightFilters;
+
+	/** Perception events received since the last batch, one per actor */
+	TArray<FShooterPerceptionEvent> PendingPerceptionEvents;
+
+	/** Batch waiting on its line of sight traces */
+	TArray<FShooterPerceptionEvent> InFlightPerceptionEvents;
+
+	/** Number of line of sight traces the in flight batch is waiting on */
+	int32 NumPendingPerceptionTraces = 0;
+
+	/** Incremented when the in flight batch is discarded, so late traces are ignored */
+	uint32 PerceptionBatchSerial = 0;
+
 public:
 
-	/** Called when an AI perception has been updated. StateTree task delegate hook */
-	FShooterPerceptionUpdatedDelegate OnShooterPerceptionUpdated;
+	/** Called once per batch with the deduplicated perception events. StateTree task delegate hook */
+	FShooterPerceptionEventsDelegate OnShooterPerceptionEvents;
+
+	/** Adds a listener's line of sight filter. Listeners should add one while they're bound */
+	void AddLineOfSightFilter(const FShooterLineOfSightFilter& Filter);
 
-	/** Called when an AI perception has been forgotten. StateTree task delegate hook */
-	FShooterPerceptionForgottenDelegate OnShooterPerceptionForgotten;
+	/** Removes a line of sight filter added by a listener */
+	void RemoveLineOfSightFilter(const FShooterLineOfSightFilter& Filter);
 
 public:
 
@@ -56,6 +117,16 @@ protected:
 	/** Pawn initialization */
 	virtual void OnPossess(APawn* InPawn) override;
 
+public:
+
+	/** Stops the StateTree, movement and ticking while the pawn waits in the NPC pool. Undone by the next possession */
+	void EnterDormantState();
+
+public:
+
+	/** Delivers and starts perception batches */
+	virtual void Tick(float DeltaTime) override;
+
 protected:
 
 	/** Called when the possessed pawn dies */
@@ -73,6 +144,9 @@ public:
 	/** Returns the targeted enemy */
 	AActor* GetCurrentTarget() const { return TargetEnemy; };
 
+	/** Fills the EQS context with the targeted enemy, or this controller if there's none. Built at most once per frame */
+	void GetTargetQueryContext(FEnvQueryContextData& OutContextData);
+
 protected:
 
 	/** Called when the AI perception component updates a perception on a given actor */
@@ -82,4 +156,19 @@ protected:
 	/** Called when the AI perception component forgets a given actor */
 	UFUNCTION()
 	void OnPerceptionForgotten(AActor* Actor);
+
+	/** Returns the pending event for the actor, adding one if needed */
+	FShooterPerceptionEvent& FindOrAddPendingEvent(AActor* Actor);
+
+	/** Moves the pending events to a new batch and starts its line of sight traces */
+	void StartPerceptionBatch();
+
+	/** Delivers the in flight batch to the listeners */
+	void DeliverPerceptionBatch();
+
+	/** Discards all buffered perception events */
+	void ClearPerceptionEvents();
+
+	/** Called when a batched line of sight trace completes */
+	void OnPerceptionTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, uint32 BatchSerial, int32 EventIndex);
 };
@@ -0,0 +1,198 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterAimBatchSubsystem.h"
+#include "ShooterNPC.h"
+#include "ProjectXSStats.h"
+#include "Engine/World.h"
+
+void UShooterAimBatchSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	RandomStream.GenerateNewSeed();
+}
+
+void UShooterAimBatchSubsystem::QueueAimRequest(AShooterNPC* NPC)
+{
+	if (!IsValid(NPC))
+	{
+		return;
+	}
+
+	FAimRequest& Request = Requests.FindOrAdd(NPC);
+
+	// already waiting for the next batch
+	if (Request.bQueued)
+	{
+		return;
+	}
+
+	++Request.Serial;
+	Request.bQueued = true;
+	Request.ResolvedTime = -1.0;
+
+	QueuedNPCs.Add(NPC);
+}
+
+void UShooterAimBatchSubsystem::CancelAimRequest(AShooterNPC* NPC)
+{
+	// the queued entry is skipped when the batch is built, and any trace in flight is ignored
+	Requests.Remove(NPC);
+}
+
+bool UShooterAimBatchSubsystem::ConsumeResolvedTarget(const AShooterNPC* NPC, FVector& OutTarget)
+{
+	FAimRequest* Request = Requests.Find(NPC);
+
+	if (!Request || Request->ResolvedTime < 0.0)
+	{
+		return false;
+	}
+
+	// every result is used for a single shot
+	const double ResolvedTime = Request->ResolvedTime;
+	Request->ResolvedTime = -1.0;
+
+	// stale results are discarded so the caller resolves the aim itself. At low frame rates a result is at least a frame old
+	const double MaxAge = FMath::Max<double>(MaxResultAge, 2.0 * GetWorld()->GetDeltaSeconds());
+
+	if (GetWorld()->GetTimeSeconds() - ResolvedTime > MaxAge)
+	{
+		return false;
+	}
+
+	OutTarget = Request->ResolvedTarget;
+	return true;
+}
+
+void UShooterAimBatchSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	BuildBatch();
+	GatherAimInputs();
+	SampleAimDirections();
+	SubmitTraces();
+}
+
+TStatId UShooterAimBatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterAimBatchSubsystem, STATGROUP_Tickables);
+}
+
+void UShooterAimBatchSubsystem::BuildBatch()
+{
+	BatchNPCs.Reset();
+	BatchSerials.Reset();
+
+	for (const TWeakObjectPtr<AShooterNPC>& WeakNPC : QueuedNPCs)
+	{
+		AShooterNPC* NPC = WeakNPC.Get();
+		FAimRequest* Request = NPC ? Requests.Find(NPC) : nullptr;
+
+		// the NPC went away or cancelled its request
+		if (!Request || !Request->bQueued)
+		{
+			continue;
+		}
+
+		Request->bQueued = false;
+
+		BatchNPCs.Add(WeakNPC);
+		BatchSerials.Add(Request->Serial);
+	}
+
+	QueuedNPCs.Reset();
+
+	const int32 Num = BatchNPCs.Num();
+
+	AimSources.SetNumUninitialized(Num, EAllowShrinking::No);
+	AimForwards.SetNumUninitialized(Num, EAllowShrinking::No);
+	TargetLocations.SetNumUninitialized(Num, EAllowShrinking::No);
+	HasTargets.SetNumUninitialized(Num, EAllowShrinking::No);
+	OffsetRanges.SetNumUninitialized(Num, EAllowShrinking::No);
+	OffsetsZ.SetNumUninitialized(Num, EAllowShrinking::No);
+	ConeHalfAngles.SetNumUninitialized(Num, EAllowShrinking::No);
+	AimRanges.SetNumUninitialized(Num, EAllowShrinking::No);
+	AimDirections.SetNumUninitialized(Num, EAllowShrinking::No);
+}
+
+void UShooterAimBatchSubsystem::GatherAimInputs()
+{
+	for (int32 i = 0; i < BatchNPCs.Num(); ++i)
+	{
+		const AShooterNPC* NPC = BatchNPCs[i].Get();
+
+		NPC->GetAimSource(AimSources[i], AimForwards[i]);
+
+		const AActor* Target = NPC->GetCurrentAimTarget();
+		HasTargets[i] = Target != nullptr;
+		TargetLocations[i] = Target ? Target->GetActorLocation() : FVector::ZeroVector;
+
+		float MinOffsetZ, MaxOffsetZ, VarianceHalfAngle;
+		NPC->GetAimSettings(AimRanges[i], VarianceHalfAngle, MinOffsetZ, MaxOffsetZ);
+
+		OffsetRanges[i] = FVector2f(MinOffsetZ, MaxOffsetZ);
+		ConeHalfAngles[i] = FMath::DegreesToRadians(VarianceHalfAngle);
+	}
+}
+
+void UShooterAimBatchSubsystem::SampleAimDirections()
+{
+	const int32 Num = BatchNPCs.Num();
+
+	// sample the vertical offsets to target head/feet
+	for (int32 i = 0; i < Num; ++i)
+	{
+		OffsetsZ[i] = RandomStream.FRandRange(OffsetRanges[i].X, OffsetRanges[i].Y);
+	}
+
+	// aim at the offset target, or along the aim source facing if there's no target
+	for (int32 i = 0; i < Num; ++i)
+	{
+		const FVector OffsetTarget(TargetLocations[i].X, TargetLocations[i].Y, TargetLocations[i].Z + OffsetsZ[i]);
+		AimDirections[i] = HasTargets[i] ? (OffsetTarget - AimSources[i]).GetSafeNormal() : AimForwards[i];
+	}
+
+	// apply randomness in a cone
+	for (int32 i = 0; i < Num; ++i)
+	{
+		AimDirections[i] = RandomStream.VRandCone(AimDirections[i], ConeHalfAngles[i]);
+	}
+}
+
+void UShooterAimBatchSubsystem::SubmitTraces()
+{
+	UWorld* World = GetWorld();
+
+	for (int32 i = 0; i < BatchNPCs.Num(); ++i)
+	{
+		const FVector TraceEnd = AimSources[i] + AimDirections[i] * AimRanges[i];
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ShooterAimBatch), false);
+		QueryParams.AddIgnoredActor(BatchNPCs[i].Get());
+
+		FTraceDelegate TraceDelegate = FTraceDelegate::CreateUObject(this, &UShooterAimBatchSubsystem::OnAimTraceDone, BatchNPCs[i], BatchSerials[i]);
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, AimSources[i], TraceEnd, ECC_Visibility, QueryParams, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate);
+	}
+
+	XS_INC_TRACES(BatchNPCs.Num());
+}
+
+void UShooterAimBatchSubsystem::OnAimTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, TWeakObjectPtr<AShooterNPC> NPC, uint32 Serial)
+{
+	FAimRequest* Request = NPC.IsValid() ? Requests.Find(NPC.Get()) : nullptr;
+
+	// the request was cancelled or replaced while the trace was in flight
+	if (!Request || Request->Serial != Serial)
+	{
+		return;
+	}
+
+	// use either the impact point or the trace end
+	const FHitResult* Hit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& Result) { return Result.bBlockingHit; });
+
+	Request->ResolvedTarget = Hit ? Hit->ImpactPoint : TraceDatum.End;
+	Request->ResolvedTime = GetWorld()->GetTimeSeconds();
+}
@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "UObject/ObjectKey.h"
+#include "ShooterAimBatchSubsystem.generated.h"
+
+class AShooterNPC;
+
+/**
+ *  Resolves the aim of shooting NPCs in one batch per frame
+ *  NPCs queue an aim request shortly before their weapon refires. Each frame the subsystem gathers
+ *  the aim inputs of the queued requests into flat arrays, samples all vertical offsets and spread
+ *  cones in one pass, and submits every obstruction trace to the async trace batch.
+ *  The NPC consumes the resolved aim point on its next shot, so every shot still gets its own spread
+ */
+UCLASS(config="Game")
+class PROJECTXS_API UShooterAimBatchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Aim request state for an NPC */
+	struct FAimRequest
+	{
+		/** Incremented on every queued request, so traces for cancelled requests are ignored */
+		uint32 Serial = 0;
+
+		/** True while the request waits for the next batch */
+		bool bQueued = false;
+
+		/** Resolved aim point */
+		FVector ResolvedTarget = FVector::ZeroVector;
+
+		/** World time the aim point was resolved at. Negative if there's no unconsumed result */
+		double ResolvedTime = -1.0;
+	};
+
+protected:
+
+	/** Time a resolved aim point stays usable, raised to two frames at low frame rates. Older results fall back to a synchronous trace */
+	UPROPERTY(Config)
+	float MaxResultAge = 0.15f;
+
+	/** Aim request state for every NPC that requested aim */
+	TMap<FObjectKey, FAimRequest> Requests;
+
+	/** NPCs waiting for the next batch, in request order */
+	TArray<TWeakObjectPtr<AShooterNPC>> QueuedNPCs;
+
+	/** NPCs in the current batch. Every array below is indexed the same way */
+	TArray<TWeakObjectPtr<AShooterNPC>> BatchNPCs;
+
+	/** Request serial per NPC */
+	TArray<uint32> BatchSerials;
+
+	/** Aim origin per NPC */
+	TArray<FVector> AimSources;
+
+	/** Aim source facing per NPC, used when there's no target */
+	TArray<FVector> AimForwards;
+
+	/** Target location per NPC */
+	TArray<FVector> TargetLocations;
+
+	/** True if the NPC has a target */
+	TArray<bool> HasTargets;
+
+	/** Vertical aim offset range per NPC */
+	TArray<FVector2f> OffsetRanges;
+
+	/** Sampled vertical offset per NPC */
+	TArray<float> OffsetsZ;
+
+	/** Spread cone half angle per NPC, in radians */
+	TArray<float> ConeHalfAngles;
+
+	/** Aim range per NPC */
+	TArray<float> AimRanges;
+
+	/** Sampled aim direction per NPC */
+	TArray<FVector> AimDirections;
+
+	/** Random stream shared by the whole batch */
+	FRandomStream RandomStream;
+
+public:
+
+	/** Seeds the batch random stream */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Queues an aim request for the NPC's next shot */
+	void QueueAimRequest(AShooterNPC* NPC);
+
+	/** Drops the NPC's queued request and any unconsumed result */
+	void CancelAimRequest(AShooterNPC* NPC);
+
+	/** Returns the NPC's resolved aim point if there's a fresh one, and consumes it */
+	bool ConsumeResolvedTarget(const AShooterNPC* NPC, FVector& OutTarget);
+
+	//~Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return QueuedNPCs.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	//~End FTickableGameObject interface
+
+protected:
+
+	/** Moves the queued requests into the batch arrays */
+	void BuildBatch();
+
+	/** Reads the aim inputs of every NPC in the batch */
+	void GatherAimInputs();
+
+	/** Samples the vertical offsets and spread cones of every NPC in the batch */
+	void SampleAimDirections();
+
+	/** Submits the obstruction traces of every NPC in the batch */
+	void SubmitTraces();
+
+	/** Stores the result of an obstruction trace */
+	void OnAimTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, TWeakObjectPtr<AShooterNPC> NPC, uint32 Serial);
+};
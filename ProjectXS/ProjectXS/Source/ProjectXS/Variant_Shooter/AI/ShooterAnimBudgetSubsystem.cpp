@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterAnimBudgetSubsystem.h"
+#include "ShooterNPC.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+void UShooterAnimBudgetSubsystem::RegisterNPC(AShooterNPC* NPC)
+{
+	if (!IsValid(NPC))
+	{
+		return;
+	}
+
+	const bool bAlreadyRegistered = BudgetedNPCs.ContainsByPredicate([NPC](const FBudgetedNPC& Budgeted)
+	{
+		return Budgeted.NPC == NPC;
+	});
+
+	if (!bAlreadyRegistered)
+	{
+		FBudgetedNPC& Budgeted = BudgetedNPCs.AddDefaulted_GetRef();
+		Budgeted.NPC = NPC;
+	}
+}
+
+void UShooterAnimBudgetSubsystem::UnregisterNPC(AShooterNPC* NPC)
+{
+	BudgetedNPCs.RemoveAllSwap([NPC](const FBudgetedNPC& Budgeted)
+	{
+		return Budgeted.NPC == NPC || !Budgeted.NPC.IsValid();
+	});
+}
+
+void UShooterAnimBudgetSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// amortize the evaluation over several frames
+	const int32 NumToEvaluate = FMath::Min(NPCsEvaluatedPerTick, BudgetedNPCs.Num());
+
+	for (int32 i = 0; i < NumToEvaluate; ++i)
+	{
+		NextEvaluatedIndex = (NextEvaluatedIndex + 1) % BudgetedNPCs.Num();
+
+		FBudgetedNPC& Budgeted = BudgetedNPCs[NextEvaluatedIndex];
+		AShooterNPC* NPC = Budgeted.NPC.Get();
+
+		if (!IsValid(NPC))
+		{
+			continue;
+		}
+
+		// only touch the mesh when the tier changes. The tier is only kept once it's applied,
+		// so NPCs whose update rate params don't exist yet are retried on their next evaluation
+		const int32 NewTier = FindTier(NPC);
+
+		if (NewTier != Budgeted.Tier && ApplyTier(NPC, NewTier))
+		{
+			Budgeted.Tier = NewTier;
+		}
+	}
+}
+
+TStatId UShooterAnimBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterAnimBudgetSubsystem, STATGROUP_Tickables);
+}
+
+int32 UShooterAnimBudgetSubsystem::FindTier(const AShooterNPC* NPC) const
+{
+	const FVector NPCLocation = NPC->GetActorLocation();
+
+	// find the closest local player view
+	float ClosestDistance = TNumericLimits<float>::Max();
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+
+		if (PC && PC->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+			ClosestDistance = FMath::Min(ClosestDistance, static_cast<float>(FVector::Dist(ViewLocation, NPCLocation)));
+		}
+	}
+
+	for (int32 i = 0; i < Tiers.Num(); ++i)
+	{
+		if (ClosestDistance <= Tiers[i].MaxDistance)
+		{
+			return i;
+		}
+	}
+
+	return Tiers.Num() - 1;
+}
+
+bool UShooterAnimBudgetSubsystem::ApplyTier(AShooterNPC* NPC, int32 TierIndex) const
+{
+	if (!Tiers.IsValidIndex(TierIndex))
+	{
+		return false;
+	}
+
+	const FShooterAnimBudgetTier& Tier = Tiers[TierIndex];
+	USkeletalMeshComponent* Mesh = NPC->GetMesh();
+
+	// suppress ticking while off screen
+	Mesh->VisibilityBasedAnimTickOption = Tier.TickOption;
+
+	// the update rate params are created lazily by the first optimized tick
+	if (FAnimUpdateRateParameters* UpdateRateParams = Mesh->AnimUpdateRateParams)
+	{
+		UpdateRateParams->BaseVisibleDistanceFactorThesholds = Tier.VisibleDistanceFactorThresholds;
+		UpdateRateParams->MaxEvalRateForInterpolation = Tier.MaxEvalRateForInterpolation;
+		UpdateRateParams->BaseNonRenderedUpdateRate = Tier.NonRenderedUpdateRate;
+		UpdateRateParams->bInterpolateSkippedFrames = Tier.bInterpolateSkippedFrames;
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "ShooterAnimBudgetSubsystem.generated.h"
+
+class AShooterNPC;
+
+/**
+ *  Animation update settings for a band of NPC significance
+ */
+USTRUCT()
+struct FShooterAnimBudgetTier
+{
+	GENERATED_BODY()
+
+	/** Max distance to the closest player view for NPCs in this tier */
+	UPROPERTY()
+	float MaxDistance = 0.0f;
+
+	/** Screen size thresholds used by update rate optimization to pick frame skipping while rendered */
+	UPROPERTY()
+	TArray<float> VisibleDistanceFactorThresholds;
+
+	/** Max frame skip at which skipped frames are still interpolated */
+	UPROPERTY()
+	int32 MaxEvalRateForInterpolation = 4;
+
+	/** Frame skip while not rendered */
+	UPROPERTY()
+	int32 NonRenderedUpdateRate = 4;
+
+	/** If true, frames skipped while rendered are interpolated */
+	UPROPERTY()
+	bool bInterpolateSkippedFrames = true;
+
+	/** What the anim graph does while the mesh isn't rendered */
+	UPROPERTY()
+	EVisibilityBasedAnimTickOption TickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+};
+
+/**
+ *  Budgets third person animation for shooter NPCs on machines that render them
+ *  Periodically ranks NPCs by distance to the local players and applies the matching
+ *  update rate optimization tier, so distant and off-screen NPCs skip and interpolate frames
+ */
+UCLASS(config="Game")
+class PROJECTXS_API UShooterAnimBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Registered NPC and its current tier */
+	struct FBudgetedNPC
+	{
+		TWeakObjectPtr<AShooterNPC> NPC;
+		int32 Tier = INDEX_NONE;
+	};
+
+protected:
+
+	/** Significance tiers, sorted by ascending max distance. The last tier catches everything beyond. Set up in DefaultGame.ini */
+	UPROPERTY(Config)
+	TArray<FShooterAnimBudgetTier> Tiers;
+
+	/** Number of NPCs re-evaluated each frame */
+	UPROPERTY(Config)
+	int32 NPCsEvaluatedPerTick = 8;
+
+	/** Registered NPCs */
+	TArray<FBudgetedNPC> BudgetedNPCs;
+
+	/** Next NPC to evaluate */
+	int32 NextEvaluatedIndex = 0;
+
+public:
+
+	/** Adds an NPC to the animation budget */
+	void RegisterNPC(AShooterNPC* NPC);
+
+	/** Removes an NPC from the animation budget */
+	void UnregisterNPC(AShooterNPC* NPC);
+
+	//~Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return BudgetedNPCs.Num() > 0 && Tiers.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	//~End FTickableGameObject interface
+
+protected:
+
+	/** Returns the tier index for an NPC */
+	int32 FindTier(const AShooterNPC* NPC) const;
+
+	/** Applies a tier's settings to an NPC's third person mesh. Returns false if the mesh isn't ready for them yet */
+	bool ApplyTier(AShooterNPC* NPC, int32 TierIndex) const;
+};
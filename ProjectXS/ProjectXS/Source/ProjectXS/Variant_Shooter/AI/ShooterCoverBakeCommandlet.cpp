@@ -0,0 +1,301 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterCoverBakeCommandlet.h"
+#include "ShooterCoverSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "Engine/LevelBounds.h"
+#include "NavigationSystem.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "Algo/SortBy.h"
+#include "ProjectXS.h"
+
+UShooterCoverBakeCommandlet::UShooterCoverBakeCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UShooterCoverBakeCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString MapPackageName;
+
+	if (!FParse::Value(*Params, TEXT("Map="), MapPackageName))
+	{
+		UE_LOG(LogProjectXS, Error, TEXT("ShooterCoverBake: missing -Map=<package name>"));
+		return 1;
+	}
+
+	FString OutputDirectory = GetDefault<UShooterCoverSubsystem>()->GetCoverDatabaseDirectory();
+	FParse::Value(*Params, TEXT("OutputDir="), OutputDirectory);
+	FParse::Value(*Params, TEXT("Spacing="), SampleSpacing);
+	FParse::Value(*Params, TEXT("ClusterSize="), ClusterSize);
+	FParse::Value(*Params, TEXT("ProbeDistance="), ProbeDistance);
+	FParse::Value(*Params, TEXT("MaxVisibilityDistance="), MaxVisibilityDistance);
+
+	// load the map
+	UPackage* MapPackage = LoadPackage(nullptr, *MapPackageName, LOAD_None);
+	UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+
+	if (!World)
+	{
+		UE_LOG(LogProjectXS, Error, TEXT("ShooterCoverBake: could not load map %s"), *MapPackageName);
+		return 1;
+	}
+
+	if (World->IsPartitionedWorld())
+	{
+		UE_LOG(LogProjectXS, Warning, TEXT("ShooterCoverBake: %s is partitioned, only always loaded actors are baked"), *MapPackageName);
+	}
+
+	// initialize the world for collision and navigation queries
+	World->AddToRoot();
+	World->WorldType = EWorldType::Editor;
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+	WorldContext.SetCurrentWorld(World);
+
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.RequiresHitProxies(false)
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(true)
+			.CreateNavigation(true)
+			.CreateAISystem(false)
+			.AllowAudioPlayback(false));
+	}
+
+	World->UpdateWorldComponents(true, false);
+
+	// bake
+	TArray<FShooterCoverPoint> Points;
+	TArray<FShooterCoverCluster> Clusters;
+	TArray<uint32> VisibilityBits;
+
+	BakeCoverPoints(World, Points);
+	BuildClusters(Points, Clusters);
+	BakeVisibility(World, Points, Clusters, VisibilityBits);
+
+	UE_LOG(LogProjectXS, Display, TEXT("ShooterCoverBake: %d cover points in %d clusters"), Points.Num(), Clusters.Num());
+
+	// tear the world down
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+
+	// save the database
+	const FString DatabasePackageName = UShooterCoverSubsystem::GetCoverDatabasePackageName(OutputDirectory, FPackageName::GetShortName(MapPackageName));
+
+	UPackage* DatabasePackage = CreatePackage(*DatabasePackageName);
+	DatabasePackage->FullyLoad();
+
+	UShooterCoverDatabase* Database = NewObject<UShooterCoverDatabase>(DatabasePackage, *FPackageName::GetShortName(DatabasePackageName), RF_Public | RF_Standalone);
+	Database->SetBakedData(ClusterSize, MoveTemp(Points), MoveTemp(Clusters), MoveTemp(VisibilityBits));
+	DatabasePackage->MarkPackageDirty();
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+
+	const FString Filename = FPackageName::LongPackageNameToFilename(DatabasePackageName, FPackageName::GetAssetPackageExtension());
+
+	if (!UPackage::SavePackage(DatabasePackage, Database, *Filename, SaveArgs))
+	{
+		UE_LOG(LogProjectXS, Error, TEXT("ShooterCoverBake: could not save %s"), *Filename);
+		return 1;
+	}
+
+	UE_LOG(LogProjectXS, Display, TEXT("ShooterCoverBake: saved %s"), *Filename);
+	return 0;
+#else
+	return 1;
+#endif
+}
+
+#if WITH_EDITOR
+void UShooterCoverBakeCommandlet::BakeCoverPoints(UWorld* World, TArray<FShooterCoverPoint>& OutPoints) const
+{
+	const FBox Bounds = ALevelBounds::CalculateLevelBounds(World->PersistentLevel);
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const bool bHasNavigation = NavSys && NavSys->GetDefaultNavDataInstance() != nullptr;
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ShooterCoverBake), false);
+
+	for (float X = Bounds.Min.X; X <= Bounds.Max.X; X += SampleSpacing)
+	{
+		for (float Y = Bounds.Min.Y; Y <= Bounds.Max.Y; Y += SampleSpacing)
+		{
+			// walk down through the stacked floors at this location
+			FVector TraceStart(X, Y, Bounds.Max.Z);
+			const FVector TraceEnd(X, Y, Bounds.Min.Z);
+
+			for (int32 Floor = 0; Floor < MaxFloorsPerSample; ++Floor)
+			{
+				FHitResult FloorHit;
+
+				if (!World->LineTraceSingleByChannel(FloorHit, TraceStart, TraceEnd, ECC_Visibility, QueryParams))
+				{
+					break;
+				}
+
+				TraceStart = FloorHit.ImpactPoint - FVector(0.0f, 0.0f, HighCoverHeight);
+
+				// skip steep surfaces
+				if (FloorHit.ImpactNormal.Z < 0.7f)
+				{
+					continue;
+				}
+
+				// skip floors the NPCs can't reach
+				if (bHasNavigation)
+				{
+					FNavLocation NavLocation;
+
+					if (!NavSys->ProjectPointToNavigation(FloorHit.ImpactPoint, NavLocation, FVector(SampleSpacing * 0.5f, SampleSpacing * 0.5f, 50.0f)))
+					{
+						continue;
+					}
+				}
+
+				FShooterCoverPoint CoverPoint;
+
+				if (ProbeCover(World, FloorHit.ImpactPoint, CoverPoint))
+				{
+					OutPoints.Add(CoverPoint);
+				}
+			}
+		}
+	}
+}
+
+bool UShooterCoverBakeCommandlet::ProbeCover(UWorld* World, const FVector& FloorLocation, FShooterCoverPoint& OutPoint) const
+{
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ShooterCoverBake), false);
+
+	const FVector LowStart = FloorLocation + FVector(0.0f, 0.0f, LowCoverHeight);
+	const FVector HighStart = FloorLocation + FVector(0.0f, 0.0f, HighCoverHeight);
+
+	float ClosestDistance = TNumericLimits<float>::Max();
+	float CoverYaw = 0.0f;
+
+	// find the closest obstacle at crouch height
+	for (int32 i = 0; i < NumProbeDirections; ++i)
+	{
+		const float Yaw = 360.0f * i / NumProbeDirections;
+		const FVector Direction = FRotator(0.0f, Yaw, 0.0f).Vector();
+
+		FHitResult OutHit;
+
+		if (World->LineTraceSingleByChannel(OutHit, LowStart, LowStart + Direction * ProbeDistance, ECC_Visibility, QueryParams) && OutHit.Distance < ClosestDistance)
+		{
+			ClosestDistance = OutHit.Distance;
+			CoverYaw = Yaw;
+		}
+	}
+
+	if (ClosestDistance == TNumericLimits<float>::Max())
+	{
+		return false;
+	}
+
+	// check if the obstacle also covers a standing character
+	FHitResult HighHit;
+	const FVector CoverDirection = FRotator(0.0f, CoverYaw, 0.0f).Vector();
+
+	OutPoint.Location = FVector3f(FloorLocation);
+	OutPoint.CoverYaw = static_cast<uint8>(FMath::RoundToInt32(CoverYaw * 256.0f / 360.0f) & 0xFF);
+	OutPoint.bHighCover = World->LineTraceSingleByChannel(HighHit, HighStart, HighStart + CoverDirection * ProbeDistance, ECC_Visibility, QueryParams);
+
+	return true;
+}
+
+void UShooterCoverBakeCommandlet::BuildClusters(TArray<FShooterCoverPoint>& InOutPoints, TArray<FShooterCoverCluster>& OutClusters) const
+{
+	// sort the points by cell so each cluster is a contiguous range
+	Algo::SortBy(InOutPoints, [this](const FShooterCoverPoint& Point)
+	{
+		const FIntVector Cell = UShooterCoverDatabase::GetCell(FVector(Point.Location), ClusterSize);
+		return MakeTuple(Cell.X, Cell.Y, Cell.Z);
+	});
+
+	for (int32 i = 0; i < InOutPoints.Num(); ++i)
+	{
+		const FIntVector Cell = UShooterCoverDatabase::GetCell(FVector(InOutPoints[i].Location), ClusterSize);
+
+		if (OutClusters.IsEmpty() || OutClusters.Last().Cell != Cell)
+		{
+			FShooterCoverCluster& Cluster = OutClusters.AddDefaulted_GetRef();
+			Cluster.Cell = Cell;
+			Cluster.FirstPoint = i;
+		}
+
+		++OutClusters.Last().NumPoints;
+	}
+}
+
+void UShooterCoverBakeCommandlet::BakeVisibility(UWorld* World, const TArray<FShooterCoverPoint>& Points, const TArray<FShooterCoverCluster>& Clusters, TArray<uint32>& OutVisibilityBits) const
+{
+	const int32 NumClusters = Clusters.Num();
+	const int32 NumWordsPerRow = UShooterCoverDatabase::GetNumWordsPerRow(NumClusters);
+
+	OutVisibilityBits.SetNumZeroed(NumClusters * NumWordsPerRow);
+
+	auto SetVisible = [&OutVisibilityBits, NumWordsPerRow](int32 From, int32 To)
+	{
+		const int32 Bit = From * NumWordsPerRow * 32 + To;
+		OutVisibilityBits[Bit / 32] |= 1u << (Bit % 32);
+	};
+
+	// pick a few evenly spread points in each cluster as trace endpoints
+	auto GetSample = [&Points, this](const FShooterCoverCluster& Cluster, int32 Sample)
+	{
+		const int32 NumSamples = FMath::Min(VisibilitySamplesPerCluster, Cluster.NumPoints);
+		const int32 PointIndex = Cluster.FirstPoint + (Sample * Cluster.NumPoints) / NumSamples;
+		return FVector(Points[PointIndex].Location) + FVector(0.0f, 0.0f, EyeHeight);
+	};
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ShooterCoverBake), false);
+
+	for (int32 A = 0; A < NumClusters; ++A)
+	{
+		// a cluster always sees itself
+		SetVisible(A, A);
+
+		const int32 NumSamplesA = FMath::Min(VisibilitySamplesPerCluster, Clusters[A].NumPoints);
+
+		for (int32 B = A + 1; B < NumClusters; ++B)
+		{
+			const int32 NumSamplesB = FMath::Min(VisibilitySamplesPerCluster, Clusters[B].NumPoints);
+
+			if (FVector::Dist(GetSample(Clusters[A], 0), GetSample(Clusters[B], 0)) > MaxVisibilityDistance)
+			{
+				continue;
+			}
+
+			// the clusters see each other if any pair of samples has an unobstructed line
+			bool bVisible = false;
+
+			for (int32 SampleA = 0; SampleA < NumSamplesA && !bVisible; ++SampleA)
+			{
+				for (int32 SampleB = 0; SampleB < NumSamplesB && !bVisible; ++SampleB)
+				{
+					FHitResult OutHit;
+					bVisible = !World->LineTraceSingleByChannel(OutHit, GetSample(Clusters[A], SampleA), GetSample(Clusters[B], SampleB), ECC_Visibility, QueryParams);
+				}
+			}
+
+			if (bVisible)
+			{
+				SetVisible(A, B);
+				SetVisible(B, A);
+			}
+		}
+	}
+}
+#endif
@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ShooterCoverDatabase.h"
+#include "ShooterCoverBakeCommandlet.generated.h"
+
+/**
+ *  Bakes a cover database for a level
+ *  Samples the floor on a grid, probes each sample for nearby obstacles, groups the cover points
+ *  into clusters and traces between clusters to build the visibility bit matrix.
+ *
+ *  Usage: UnrealEditor-Cmd ProjectXS -run=ShooterCoverBake -Map=/Game/Variant_Shooter/Lvl_Shooter
+ *  Optional: -Spacing= -ClusterSize= -ProbeDistance= -MaxVisibilityDistance=
+ */
+UCLASS()
+class PROJECTXS_API UShooterCoverBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Distance between floor samples */
+	float SampleSpacing = 100.0f;
+
+	/** Size of a cluster grid cell */
+	float ClusterSize = 1000.0f;
+
+	/** Max distance from a sample to its covering obstacle */
+	float ProbeDistance = 100.0f;
+
+	/** Number of horizontal directions probed for obstacles around each sample */
+	int32 NumProbeDirections = 8;
+
+	/** Height of a crouching character's head, used to detect low cover */
+	float LowCoverHeight = 60.0f;
+
+	/** Height of a standing character's head, used to detect high cover */
+	float HighCoverHeight = 150.0f;
+
+	/** Max number of stacked floors sampled at each grid location */
+	int32 MaxFloorsPerSample = 4;
+
+	/** Clusters further apart than this are never visible to each other */
+	float MaxVisibilityDistance = 8000.0f;
+
+	/** Max number of points per cluster used as visibility trace endpoints */
+	int32 VisibilitySamplesPerCluster = 3;
+
+	/** Height above the floor for visibility traces */
+	float EyeHeight = 150.0f;
+
+public:
+
+	UShooterCoverBakeCommandlet();
+
+	/** Runs the bake */
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+
+#if WITH_EDITOR
+	/** Finds cover points on the floor of the world */
+	void BakeCoverPoints(UWorld* World, TArray<FShooterCoverPoint>& OutPoints) const;
+
+	/** Sorts the points into clusters */
+	void BuildClusters(TArray<FShooterCoverPoint>& InOutPoints, TArray<FShooterCoverCluster>& OutClusters) const;
+
+	/** Traces between clusters to build the visibility bit matrix */
+	void BakeVisibility(UWorld* World, const TArray<FShooterCoverPoint>& Points, const TArray<FShooterCoverCluster>& Clusters, TArray<uint32>& OutVisibilityBits) const;
+
+	/** Probes around a floor location for a covering obstacle */
+	bool ProbeCover(UWorld* World, const FVector& FloorLocation, FShooterCoverPoint& OutPoint) const;
+#endif
+};
@@ -0,0 +1,157 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterCoverDatabase.h"
+#include "Algo/BinarySearch.h"
+
+void UShooterCoverDatabase::PostLoad()
+{
+	Super::PostLoad();
+
+	BuildLookup();
+}
+
+#if WITH_EDITOR
+void UShooterCoverDatabase::SetBakedData(float InClusterSize, TArray<FShooterCoverPoint>&& InPoints, TArray<FShooterCoverCluster>&& InClusters, TArray<uint32>&& InVisibilityBits)
+{
+	ClusterSize = InClusterSize;
+	Points = MoveTemp(InPoints);
+	Clusters = MoveTemp(InClusters);
+	VisibilityBits = MoveTemp(InVisibilityBits);
+
+	BuildLookup();
+}
+#endif
+
+FVector UShooterCoverDatabase::GetCoverDirection(int32 PointIndex) const
+{
+	const float Yaw = Points[PointIndex].CoverYaw * (360.0f / 256.0f);
+	return FRotator(0.0f, Yaw, 0.0f).Vector();
+}
+
+void UShooterCoverDatabase::GatherPointsInRadius(const FVector& Center, float Radius, TArray<int32>& OutPoints) const
+{
+	const FIntVector MinCell = GetCell(Center - FVector(Radius), ClusterSize);
+	const FIntVector MaxCell = GetCell(Center + FVector(Radius), ClusterSize);
+	const float RadiusSquared = FMath::Square(Radius);
+
+	// only visit the clusters overlapping the radius
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const int32* ClusterIndex = ClusterLookup.Find(FIntVector(X, Y, Z));
+
+				if (!ClusterIndex)
+				{
+					continue;
+				}
+
+				const FShooterCoverCluster& Cluster = Clusters[*ClusterIndex];
+
+				for (int32 PointIndex = Cluster.FirstPoint; PointIndex < Cluster.FirstPoint + Cluster.NumPoints; ++PointIndex)
+				{
+					if (FVector::DistSquared(GetPointLocation(PointIndex), Center) <= RadiusSquared)
+					{
+						OutPoints.Add(PointIndex);
+					}
+				}
+			}
+		}
+	}
+}
+
+int32 UShooterCoverDatabase::FindPointAt(const FVector& Location, float Tolerance) const
+{
+	const int32 ClusterIndex = FindClusterAt(Location);
+
+	if (ClusterIndex == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	const FShooterCoverCluster& Cluster = Clusters[ClusterIndex];
+
+	int32 BestPoint = INDEX_NONE;
+	float BestDistanceSquared = FMath::Square(Tolerance);
+
+	for (int32 PointIndex = Cluster.FirstPoint; PointIndex < Cluster.FirstPoint + Cluster.NumPoints; ++PointIndex)
+	{
+		const float DistanceSquared = FVector::DistSquared(GetPointLocation(PointIndex), Location);
+
+		if (DistanceSquared <= BestDistanceSquared)
+		{
+			BestDistanceSquared = DistanceSquared;
+			BestPoint = PointIndex;
+		}
+	}
+
+	return BestPoint;
+}
+
+int32 UShooterCoverDatabase::FindClusterAt(const FVector& Location) const
+{
+	const int32* ClusterIndex = ClusterLookup.Find(GetCell(Location, ClusterSize));
+	return ClusterIndex ? *ClusterIndex : INDEX_NONE;
+}
+
+int32 UShooterCoverDatabase::GetPointCluster(int32 PointIndex) const
+{
+	// clusters are sorted by their first point
+	const int32 UpperBound = Algo::UpperBoundBy(Clusters, PointIndex, &FShooterCoverCluster::FirstPoint);
+	return UpperBound - 1;
+}
+
+bool UShooterCoverDatabase::AreClustersVisible(int32 ClusterA, int32 ClusterB) const
+{
+	if (!Clusters.IsValidIndex(ClusterA) || !Clusters.IsValidIndex(ClusterB))
+	{
+		return true;
+	}
+
+	const int32 Bit = ClusterA * GetNumWordsPerRow(Clusters.Num()) * 32 + ClusterB;
+
+	// missing visibility data, assume the worst
+	if (!VisibilityBits.IsValidIndex(Bit / 32))
+	{
+		return true;
+	}
+
+	return (VisibilityBits[Bit / 32] & (1u << (Bit % 32))) != 0;
+}
+
+bool UShooterCoverDatabase::IsCoveredFrom(int32 PointIndex, const FVector& ThreatLocation, float CoverConeDot) const
+{
+	// the threat can't see this part of the level at all
+	const int32 ThreatCluster = FindClusterAt(ThreatLocation);
+
+	if (ThreatCluster != INDEX_NONE && !AreClustersVisible(ThreatCluster, GetPointCluster(PointIndex)))
+	{
+		return true;
+	}
+
+	// otherwise the obstacle needs to be between the point and the threat
+	const FVector ThreatDir = (ThreatLocation - GetPointLocation(PointIndex)).GetSafeNormal2D();
+	return FVector::DotProduct(ThreatDir, GetCoverDirection(PointIndex)) >= CoverConeDot;
+}
+
+FIntVector UShooterCoverDatabase::GetCell(const FVector& Location, float InClusterSize)
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / InClusterSize),
+		FMath::FloorToInt32(Location.Y / InClusterSize),
+		FMath::FloorToInt32(Location.Z / InClusterSize));
+}
+
+void UShooterCoverDatabase::BuildLookup()
+{
+	ClusterLookup.Reset();
+	ClusterLookup.Reserve(Clusters.Num());
+
+	for (int32 i = 0; i < Clusters.Num(); ++i)
+	{
+		ClusterLookup.Add(Clusters[i].Cell, i);
+	}
+}
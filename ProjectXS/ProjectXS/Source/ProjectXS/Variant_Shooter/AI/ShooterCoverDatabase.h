@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ShooterCoverDatabase.generated.h"
+
+/**
+ *  Baked cover point
+ */
+USTRUCT()
+struct FShooterCoverPoint
+{
+	GENERATED_BODY()
+
+	/** Location of the point, on the floor */
+	UPROPERTY()
+	FVector3f Location = FVector3f::ZeroVector;
+
+	/** Yaw towards the covering obstacle, quantized to 256 steps */
+	UPROPERTY()
+	uint8 CoverYaw = 0;
+
+	/** True if the obstacle also covers a standing character */
+	UPROPERTY()
+	bool bHighCover = false;
+};
+
+/**
+ *  Grid cell grouping the cover points inside it
+ */
+USTRUCT()
+struct FShooterCoverCluster
+{
+	GENERATED_BODY()
+
+	/** Grid cell of this cluster */
+	UPROPERTY()
+	FIntVector Cell = FIntVector::ZeroValue;
+
+	/** Index of the first point of this cluster. Points are stored sorted by cluster */
+	UPROPERTY()
+	int32 FirstPoint = 0;
+
+	/** Number of points in this cluster */
+	UPROPERTY()
+	int32 NumPoints = 0;
+};
+
+/**
+ *  Cover point database baked offline for a level by UShooterCoverBakeCommandlet
+ *  Stores cover points grouped in grid clusters, plus a bit matrix of which clusters can see each other,
+ *  so cover can be selected at runtime without tracing
+ */
+UCLASS(BlueprintType)
+class PROJECTXS_API UShooterCoverDatabase : public UDataAsset
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Size of a cluster grid cell */
+	UPROPERTY(VisibleAnywhere, Category="Cover")
+	float ClusterSize = 1000.0f;
+
+	/** Cover points, sorted by cluster */
+	UPROPERTY()
+	TArray<FShooterCoverPoint> Points;
+
+	/** Point clusters */
+	UPROPERTY()
+	TArray<FShooterCoverCluster> Clusters;
+
+	/** Cluster visibility bit matrix, one row of NumWordsPerRow words per cluster */
+	UPROPERTY()
+	TArray<uint32> VisibilityBits;
+
+	/** Cluster lookup by grid cell, built on load */
+	TMap<FIntVector, int32> ClusterLookup;
+
+public:
+
+	/** Builds the runtime lookup */
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	/** Replaces the baked data */
+	void SetBakedData(float InClusterSize, TArray<FShooterCoverPoint>&& InPoints, TArray<FShooterCoverCluster>&& InClusters, TArray<uint32>&& InVisibilityBits);
+#endif
+
+	/** Returns the number of cover points */
+	int32 GetNumPoints() const { return Points.Num(); }
+
+	/** Returns a cover point */
+	const FShooterCoverPoint& GetPoint(int32 PointIndex) const { return Points[PointIndex]; }
+
+	/** Returns the world location of a cover point */
+	FVector GetPointLocation(int32 PointIndex) const { return FVector(Points[PointIndex].Location); }
+
+	/** Returns the direction from a cover point towards its obstacle */
+	FVector GetCoverDirection(int32 PointIndex) const;
+
+	/** Adds the indices of all cover points within the radius */
+	void GatherPointsInRadius(const FVector& Center, float Radius, TArray<int32>& OutPoints) const;
+
+	/** Returns the point closest to the location within the tolerance, or INDEX_NONE */
+	int32 FindPointAt(const FVector& Location, float Tolerance) const;
+
+	/** Returns the cluster containing the location, or INDEX_NONE */
+	int32 FindClusterAt(const FVector& Location) const;
+
+	/** Returns the cluster a point belongs to */
+	int32 GetPointCluster(int32 PointIndex) const;
+
+	/** Returns true if the baked visibility says the two clusters can see each other */
+	bool AreClustersVisible(int32 ClusterA, int32 ClusterB) const;
+
+	/**
+	 *  Returns true if the cover point protects from a threat at the given location
+	 *  Covered if the threat's cluster can't see the point's cluster, or the obstacle faces the threat
+	 */
+	bool IsCoveredFrom(int32 PointIndex, const FVector& ThreatLocation, float CoverConeDot) const;
+
+	/** Returns the number of words per visibility matrix row for the given number of clusters */
+	static int32 GetNumWordsPerRow(int32 NumClusters) { return (NumClusters + 31) / 32; }
+
+	/** Returns the grid cell containing a location */
+	static FIntVector GetCell(const FVector& Location, float InClusterSize);
+
+protected:
+
+	/** Rebuilds the cluster lookup */
+	void BuildLookup();
+};
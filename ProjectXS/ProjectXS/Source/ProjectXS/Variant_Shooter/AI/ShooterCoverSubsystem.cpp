@@ -0,0 +1,37 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterCoverSubsystem.h"
+#include "ShooterCoverDatabase.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+bool UShooterCoverSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UShooterCoverSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (CoverDatabase)
+	{
+		return;
+	}
+
+	// find the database by convention. Strip the PIE prefix so the editor finds the same asset
+	const FString MapName = UWorld::RemovePIEPrefix(FPackageName::GetShortName(InWorld.GetOutermost()->GetName()));
+	const FString PackageName = GetCoverDatabasePackageName(CoverDatabaseDirectory, MapName);
+
+	if (FPackageName::DoesPackageExist(PackageName))
+	{
+		const FString ObjectPath = PackageName + TEXT(".") + FPackageName::GetShortName(PackageName);
+		CoverDatabase = LoadObject<UShooterCoverDatabase>(nullptr, *ObjectPath);
+	}
+}
+
+FString UShooterCoverSubsystem::GetCoverDatabasePackageName(const FString& Directory, const FString& MapName)
+{
+	return Directory / (MapName + TEXT("_CoverDB"));
+}
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterCoverSubsystem.generated.h"
+
+class UShooterCoverDatabase;
+
+/**
+ *  Provides the baked cover database for the current level
+ *  Databases are found by naming convention: <CoverDatabaseDirectory>/<MapName>_CoverDB
+ */
+UCLASS(config="Game")
+class PROJECTXS_API UShooterCoverSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Content directory holding the baked cover databases */
+	UPROPERTY(Config)
+	FString CoverDatabaseDirectory = TEXT("/Game/Variant_Shooter/AI/CoverDB");
+
+	/** Cover database for this level */
+	UPROPERTY(Transient)
+	TObjectPtr<UShooterCoverDatabase> CoverDatabase;
+
+public:
+
+	/** Only create for game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Loads the cover database for this level */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Returns the cover database for this level, if one was baked */
+	UShooterCoverDatabase* GetCoverDatabase() const { return CoverDatabase; }
+
+	/** Overrides the cover database for this level */
+	void SetCoverDatabase(UShooterCoverDatabase* InCoverDatabase) { CoverDatabase = InCoverDatabase; }
+
+	/** Returns the content directory holding the baked cover databases */
+	const FString& GetCoverDatabaseDirectory() const { return CoverDatabaseDirectory; }
+
+	/** Returns the package name of the cover database for a map */
+	static FString GetCoverDatabasePackageName(const FString& Directory, const FString& MapName);
+};
@@ -0,0 +1,258 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterEQSBudgetSubsystem.h"
+#include "ShooterAIController.h"
+#include "EnvironmentQuery/EnvQuery.h"
+#include "EnvironmentQuery/EnvQueryManager.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "ProjectXS.h"
+
+int32 UShooterEQSBudgetSubsystem::RequestQuery(UEnvQuery* Query, AShooterAIController* Querier, EEnvQueryRunMode::Type RunMode, const FQueryFinishedSignature& OnFinished)
+{
+	if (!Query || !IsValid(Querier))
+	{
+		return INDEX_NONE;
+	}
+
+	FQueryRequest& Request = PendingQueries.AddDefaulted_GetRef();
+	Request.RequestId = ++LastRequestId;
+	Request.Query = Query;
+	Request.Querier = Querier;
+	Request.RunMode = RunMode;
+	Request.OnFinished = OnFinished;
+	Request.RequestTime = FPlatformTime::Seconds();
+
+	return Request.RequestId;
+}
+
+void UShooterEQSBudgetSubsystem::AbortQuery(int32 RequestId)
+{
+	// still queued, just forget about it
+	if (PendingQueries.RemoveAll([RequestId](const FQueryRequest& Request) { return Request.RequestId == RequestId; }) > 0)
+	{
+		return;
+	}
+
+	// running, we own the instance so dropping it stops the query
+	RunningQueries.RemoveAll([RequestId](const FQueryRequest& Request) { return Request.RequestId == RequestId; });
+}
+
+void UShooterEQSBudgetSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = FPlatformTime::Seconds();
+
+	DropStaleQueries(Now);
+
+	// start the highest priority queries that fit in the budget
+	const int32 NumToStart = FMath::Min3(MaxQueriesStartedPerTick, MaxRunningQueries - RunningQueries.Num(), PendingQueries.Num());
+
+	if (NumToStart > 0)
+	{
+		for (FQueryRequest& Request : PendingQueries)
+		{
+			Request.Priority = CalculatePriority(Request, Now);
+		}
+
+		PendingQueries.Sort([](const FQueryRequest& A, const FQueryRequest& B)
+		{
+			return A.Priority > B.Priority;
+		});
+
+		TArray<FQueryRequest> ToStart;
+		ToStart.Append(PendingQueries.GetData(), NumToStart);
+		PendingQueries.RemoveAt(0, NumToStart);
+
+		for (FQueryRequest& Request : ToStart)
+		{
+			StartQuery(Request);
+		}
+	}
+
+	StepRunningQueries();
+
+	UpdateStats(Now);
+}
+
+TStatId UShooterEQSBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterEQSBudgetSubsystem, STATGROUP_Tickables);
+}
+
+void UShooterEQSBudgetSubsystem::DropStaleQueries(double Now)
+{
+	TArray<FQueryRequest> Dropped;
+
+	for (int32 i = PendingQueries.Num() - 1; i >= 0; --i)
+	{
+		const FQueryRequest& Request = PendingQueries[i];
+
+		// the querier is gone, nobody is waiting for this one
+		if (!Request.Querier.IsValid() || !Request.Query.IsValid())
+		{
+			PendingQueries.RemoveAtSwap(i);
+			continue;
+		}
+
+		if (Now - Request.RequestTime > MaxQueueTime)
+		{
+			Dropped.Add(MoveTemp(PendingQueries[i]));
+			PendingQueries.RemoveAtSwap(i);
+		}
+	}
+
+	Stats.NumDropped += Dropped.Num();
+
+	// notify after we're done with the queue, in case the delegates request new queries
+	for (FQueryRequest& Request : Dropped)
+	{
+		Request.OnFinished.ExecuteIfBound(nullptr);
+	}
+}
+
+float UShooterEQSBudgetSubsystem::CalculatePriority(const FQueryRequest& Request, double Now) const
+{
+	float Priority = WaitPriorityPerSecond * static_cast<float>(Now - Request.RequestTime);
+
+	const APawn* QuerierPawn = Request.Querier.IsValid() ? Request.Querier->GetPawn() : nullptr;
+
+	if (!QuerierPawn)
+	{
+		return Priority;
+	}
+
+	// NPCs close to a player matter the most
+	float ClosestDistance = PriorityDistance;
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+
+		if (PC && PC->GetPawn())
+		{
+			ClosestDistance = FMath::Min(ClosestDistance, static_cast<float>(FVector::Dist(PC->GetPawn()->GetActorLocation(), QuerierPawn->GetActorLocation())));
+		}
+	}
+
+	return Priority + 1.0f - ClosestDistance / FMath::Max(PriorityDistance, 1.0f);
+}
+
+bool UShooterEQSBudgetSubsystem::StartQuery(FQueryRequest& Request)
+{
+	UEnvQueryManager* QueryManager = UEnvQueryManager::GetCurrent(GetWorld());
+
+	if (!QueryManager || !Request.Querier.IsValid() || !Request.Query.IsValid())
+	{
+		return false;
+	}
+
+	// prepare the instance without handing it to the EQS manager, which would step it under its global time slice
+	FEnvQueryRequest QueryRequest(Request.Query.Get(), Request.Querier.Get());
+	Request.Instance = QueryManager->PrepareQueryInstance(QueryRequest, Request.RunMode);
+
+	if (!Request.Instance.IsValid())
+	{
+		Request.OnFinished.ExecuteIfBound(nullptr);
+		return false;
+	}
+
+	RunningQueries.Add(MoveTemp(Request));
+	return true;
+}
+
+void UShooterEQSBudgetSubsystem::StepRunningQueries()
+{
+	if (RunningQueries.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<FQueryRequest> Finished;
+
+	// step the queries round robin until the budget is spent, starting where the last frame stopped
+	const double EndTime = FPlatformTime::Seconds() + MaxTestingTimePerTick;
+	int32 NumStepped = 0;
+
+	for (int32 Index = NextStepIndex % RunningQueries.Num(); RunningQueries.Num() > 0; )
+	{
+		const double TimeLeft = EndTime - FPlatformTime::Seconds();
+
+		// always step at least one query, so a tight budget still makes progress
+		if (TimeLeft <= 0.0 && NumStepped > 0)
+		{
+			NextStepIndex = Index;
+			break;
+		}
+
+		FQueryRequest& Request = RunningQueries[Index];
+		Request.Instance->ExecuteOneStep(FMath::Max(TimeLeft, 0.0));
+		++NumStepped;
+
+		if (Request.Instance->IsFinished())
+		{
+			Finished.Add(MoveTemp(Request));
+			RunningQueries.RemoveAt(Index, EAllowShrinking::No);
+
+		} else {
+
+			++Index;
+
+		}
+
+		if (Index >= RunningQueries.Num())
+		{
+			Index = 0;
+		}
+	}
+
+	// notify after we're done with the running queries, in case the delegates request new queries
+	for (FQueryRequest& Request : Finished)
+	{
+		// account for the completed query
+		++WindowCompleted;
+		WindowLatency += FPlatformTime::Seconds() - Request.RequestTime;
+
+		Request.OnFinished.ExecuteIfBound(Request.Instance);
+	}
+}
+
+void UShooterEQSBudgetSubsystem::UpdateStats(double Now)
+{
+	if (WindowStartTime == 0.0)
+	{
+		WindowStartTime = Now;
+		return;
+	}
+
+	const double WindowLength = Now - WindowStartTime;
+
+	if (WindowLength < StatsWindow)
+	{
+		return;
+	}
+
+	Stats.QueriesPerSecond = WindowCompleted / WindowLength;
+	Stats.AverageLatency = WindowCompleted > 0 ? WindowLatency / WindowCompleted : 0.0f;
+	Stats.NumPending = PendingQueries.Num();
+	Stats.NumRunning = RunningQueries.Num();
+
+#if !UE_BUILD_SHIPPING
+	if (bLogStats)
+	{
+		UE_LOG(LogProjectXS, Log, TEXT("EQS budget: %.1f queries/s, %.1f ms average latency, %d pending, %d running, %d dropped"),
+			Stats.QueriesPerSecond, Stats.AverageLatency * 1000.0f, Stats.NumPending, Stats.NumRunning, Stats.NumDropped);
+	}
+#endif
+
+	// a whole window went by without queries, so the snapshot above is zeroed.
+	// Stop the window, which lets the subsystem stop ticking until the next request
+	const bool bIdle = WindowCompleted == 0 && PendingQueries.IsEmpty() && RunningQueries.IsEmpty();
+
+	WindowStartTime = bIdle ? 0.0 : Now;
+	WindowCompleted = 0;
+	WindowLatency = 0.0;
+}
@@ -0,0 +1,147 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnvironmentQuery/EnvQueryTypes.h"
+#include "ShooterEQSBudgetSubsystem.generated.h"
+
+class UEnvQuery;
+class AShooterAIController;
+struct FEnvQueryInstance;
+
+/**
+ *  Snapshot of the EQS budget counters, refreshed once per stats window
+ */
+struct FShooterEQSBudgetStats
+{
+	/** Queries completed per second */
+	float QueriesPerSecond = 0.0f;
+
+	/** Average time from request to result, in seconds */
+	float AverageLatency = 0.0f;
+
+	/** Queries dropped because they waited too long, since the subsystem was created */
+	int32 NumDropped = 0;
+
+	/** Queries waiting to be started */
+	int32 NumPending = 0;
+
+	/** Queries currently running */
+	int32 NumRunning = 0;
+};
+
+/**
+ *  Schedules EQS queries for the shooter NPCs
+ *  Requests are queued and started a few per frame, prioritized by distance to the closest player
+ *  and by how long they've been waiting. Stale requests are dropped instead of piling up.
+ *  Running queries are stepped by the subsystem itself under its own per-frame time budget,
+ *  so other EQS users keep the EQS manager's default time slicing
+ */
+UCLASS(config="Game")
+class PROJECTXS_API UShooterEQSBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Queued or running query request */
+	struct FQueryRequest
+	{
+		int32 RequestId = INDEX_NONE;
+		TWeakObjectPtr<UEnvQuery> Query;
+		TWeakObjectPtr<AShooterAIController> Querier;
+		EEnvQueryRunMode::Type RunMode = EEnvQueryRunMode::SingleResult;
+		FQueryFinishedSignature OnFinished;
+		double RequestTime = 0.0;
+		TSharedPtr<FEnvQueryInstance> Instance;
+		float Priority = 0.0f;
+	};
+
+protected:
+
+	/** Max number of queries started each frame */
+	UPROPERTY(Config)
+	int32 MaxQueriesStartedPerTick = 4;
+
+	/** Max number of queries running at the same time */
+	UPROPERTY(Config)
+	int32 MaxRunningQueries = 16;
+
+	/** Time spent stepping the running queries each frame, in seconds */
+	UPROPERTY(Config)
+	float MaxTestingTimePerTick = 0.002f;
+
+	/** Time after which a query that hasn't been started is dropped */
+	UPROPERTY(Config)
+	float MaxQueueTime = 1.0f;
+
+	/** Distance to the closest player at which an NPC's queries get the lowest distance priority */
+	UPROPERTY(Config)
+	float PriorityDistance = 5000.0f;
+
+	/** Priority gained per second of waiting, so distant NPCs still get served */
+	UPROPERTY(Config)
+	float WaitPriorityPerSecond = 2.0f;
+
+	/** Length of the window used to compute the stats */
+	UPROPERTY(Config)
+	float StatsWindow = 1.0f;
+
+	/** If true, the stats are logged once per window */
+	UPROPERTY(Config)
+	bool bLogStats = false;
+
+	/** Queries waiting to be started */
+	TArray<FQueryRequest> PendingQueries;
+
+	/** Running queries, stepped by the subsystem */
+	TArray<FQueryRequest> RunningQueries;
+
+	/** Running query stepped first on the next frame, so every query gets its turn */
+	int32 NextStepIndex = 0;
+
+	/** Last request id handed out */
+	int32 LastRequestId = 0;
+
+	/** Stats snapshot from the last full window */
+	FShooterEQSBudgetStats Stats;
+
+	/** Counters for the current stats window */
+	double WindowStartTime = 0.0;
+	int32 WindowCompleted = 0;
+	double WindowLatency = 0.0;
+
+public:
+
+	/** Queues an EQS query for an NPC. The delegate receives a null result if the query is dropped. Returns the request id */
+	int32 RequestQuery(UEnvQuery* Query, AShooterAIController* Querier, EEnvQueryRunMode::Type RunMode, const FQueryFinishedSignature& OnFinished);
+
+	/** Aborts a queued or running query without calling its delegate */
+	void AbortQuery(int32 RequestId);
+
+	/** Returns the stats from the last full window */
+	const FShooterEQSBudgetStats& GetStats() const { return Stats; }
+
+	//~Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return PendingQueries.Num() > 0 || RunningQueries.Num() > 0 || WindowStartTime != 0.0; }
+	virtual TStatId GetStatId() const override;
+	//~End FTickableGameObject interface
+
+protected:
+
+	/** Drops queries that waited too long */
+	void DropStaleQueries(double Now);
+
+	/** Computes the priority of a queued query */
+	float CalculatePriority(const FQueryRequest& Request, double Now) const;
+
+	/** Prepares a query instance and adds it to the running queries. Returns false if it couldn't be started */
+	bool StartQuery(FQueryRequest& Request);
+
+	/** Steps the running queries within the time budget and delivers the finished ones */
+	void StepRunningQueries();
+
+	/** Rolls the stats window over if it has elapsed. Stops the window after a full window without queries */
+	void UpdateStats(double Now);
+};
@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterLeanNPC.h"
+#include "Components/SceneComponent.h"
+#include "Components/CapsuleComponent.h"
+
+AShooterLeanNPC::AShooterLeanNPC(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer
+		.DoNotCreateDefaultSubobject(AProjectXSCharacter::FirstPersonMeshComponentName)
+		.DoNotCreateDefaultSubobject(AProjectXSCharacter::FirstPersonCameraComponentName))
+{
+	// create the aim point at eye height
+	AimPoint = CreateDefaultSubobject<USceneComponent>(TEXT("Aim Point"));
+	AimPoint->SetupAttachment(GetCapsuleComponent());
+	AimPoint->SetRelativeLocation(FVector(0.0f, 0.0f, BaseEyeHeight));
+}
+
+void AShooterLeanNPC::GetAimSource(FVector& OutLocation, FVector& OutDirection) const
+{
+	// aim from the eye height point towards the controller's aim
+	OutLocation = AimPoint->GetComponentLocation();
+	OutDirection = GetBaseAimRotation().Vector();
+}
@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ShooterNPC.h"
+#include "ShooterLeanNPC.generated.h"
+
+class USceneComponent;
+
+/**
+ *  A lightweight Shooter NPC
+ *  Skips the first person mesh and camera entirely, and aims from a plain eye height scene point.
+ *  Its weapon's first person mesh is also discarded when attached
+ */
+UCLASS(abstract)
+class PROJECTXS_API AShooterLeanNPC : public AShooterNPC
+{
+	GENERATED_BODY()
+
+	/** Origin for aiming and line of sight checks */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	USceneComponent* AimPoint;
+
+public:
+
+	/** Constructor */
+	AShooterLeanNPC(const FObjectInitializer& ObjectInitializer);
+
+	/** Aims from the eye height scene point */
+	virtual void GetAimSource(FVector& OutLocation, FVector& OutDirection) const override;
+};
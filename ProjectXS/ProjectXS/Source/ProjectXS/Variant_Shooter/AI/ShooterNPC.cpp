@@ -11,11 +11,40 @@
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "TimerManager.h"
+#include "ShooterNPCPoolSubsystem.h"
+#include "ShooterRagdollSubsystem.h"
+#include "ShooterAnimBudgetSubsystem.h"
+#include "ShooterAimBatchSubsystem.h"
+#include "ShooterAIController.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+
+AShooterNPC::AShooterNPC(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// let the animation budget skip and interpolate frames on the third person mesh
+	GetMesh()->bEnableUpdateRateOptimizations = true;
+	GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+}
 
 void AShooterNPC::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// save the initial state so it can be restored if this character is recycled
+	InitialHP = CurrentHP;
+	DefaultMeshCollisionProfile = GetMesh()->GetCollisionProfileName();
+	DefaultCapsuleCollision = GetCapsuleComponent()->GetCollisionEnabled();
+
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		// nothing is rendered on a dedicated server, only keep montages and their notifies going
+		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+	}
+
+	// budget our animation updates against the local players
+	RegisterAnimBudget();
+
 	// spawn the weapon
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.Owner = this;
@@ -29,8 +58,21 @@ void AShooterNPC::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the death timer
+	// clear the death timers
 	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+	GetWorld()->GetTimerManager().ClearTimer(DeathPoseTimer);
+
+	// release our ragdoll slot
+	if (UShooterRagdollSubsystem* Ragdolls = GetWorld()->GetSubsystem<UShooterRagdollSubsystem>())
+	{
+		Ragdolls->ReleaseRagdoll(this);
+	}
+
+	// leave the animation budget
+	UnregisterAnimBudget();
+
+	// drop our pending aim
+	CancelAimRequest();
 }
 
 float AShooterNPC::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -61,7 +103,17 @@ void AShooterNPC::AttachWeaponMeshes(AShooterWeapon* WeaponToAttach)
 	WeaponToAttach->AttachToActor(this, AttachmentRule);
 
 	// attach the weapon meshes
-	WeaponToAttach->GetFirstPersonMesh()->AttachToComponent(GetFirstPersonMesh(), AttachmentRule, FirstPersonWeaponSocket);
+	if (GetFirstPersonMesh())
+	{
+		WeaponToAttach->GetFirstPersonMesh()->AttachToComponent(GetFirstPersonMesh(), AttachmentRule, FirstPersonWeaponSocket);
+
+	} else {
+
+		// we have no first person mesh, so the weapon doesn't need one either
+		WeaponToAttach->DisableFirstPersonMesh();
+
+	}
+
 	WeaponToAttach->GetThirdPersonMesh()->AttachToComponent(GetMesh(), AttachmentRule, ThirdPersonWeaponSocket);
 }
 
@@ -82,34 +134,34 @@ void AShooterNPC::UpdateWeaponHUD(int32 CurrentAmmo, int32 MagazineSize)
 
 FVector AShooterNPC::GetWeaponTargetLocation()
 {
-	// start aiming from the camera location
-	const FVector AimSource = GetFirstPersonCameraComponent()->GetComponentLocation();
+	// use the aim the batch resolved ahead of this shot, if there's one
+	UShooterAimBatchSubsystem* AimBatch = GetWorld()->GetSubsystem<UShooterAimBatchSubsystem>();
 
-	FVector AimDir, AimTarget = FVector::ZeroVector;
+	FVector ResolvedTarget;
+	const bool bResolved = AimBatch && AimBatch->ConsumeResolvedTarget(this, ResolvedTarget);
 
-	// do we have an aim target?
-	if (CurrentAimTarget)
-	{
-		// target the actor location
-		AimTarget = CurrentAimTarget->GetActorLocation();
+	// get the aim for the next shot resolved ahead of time
+	ScheduleAimRequest();
 
-		// apply a vertical offset to target head/feet
-		AimTarget.Z += FMath::RandRange(MinAimOffsetZ, MaxAimOffsetZ);
+	if (bResolved)
+	{
+		return ResolvedTarget;
+	}
 
-		// get the aim direction and apply randomness in a cone
-		AimDir = (AimTarget - AimSource).GetSafeNormal();
-		AimDir = UKismetMathLibrary::RandomUnitVectorInConeInDegrees(AimDir, AimVarianceHalfAngle);
+	// no batched aim, e.g. on the first shot, so resolve it now
 
-		
-	} else {
+	// start aiming from the aim source
+	FVector AimSource, AimForward;
+	GetAimSource(AimSource, AimForward);
 
-		// no aim target, so just use the camera facing
-		AimDir = UKismetMathLibrary::RandomUnitVectorInConeInDegrees(GetFirstPersonCameraComponent()->GetForwardVector(), AimVarianceHalfAngle);
+	// get the aim direction towards our target, if we have one
+	const bool bHasTarget = CurrentAimTarget != nullptr;
+	const FVector TargetLocation = bHasTarget ? CurrentAimTarget->GetActorLocation() : FVector::ZeroVector;
 
-	}
+	const FVector AimDir = CalculateAimDirection(AimSource, AimForward, bHasTarget, TargetLocation, MinAimOffsetZ, MaxAimOffsetZ, AimVarianceHalfAngle);
 
 	// calculate the unobstructed aim target location
-	AimTarget = AimSource + (AimDir * AimRange);
+	const FVector AimTarget = AimSource + (AimDir * AimRange);
 
 	// run a visibility trace to see if there's obstructions
 	FHitResult OutHit;
@@ -123,6 +175,38 @@ FVector AShooterNPC::GetWeaponTargetLocation()
 	return OutHit.bBlockingHit ? OutHit.ImpactPoint : OutHit.TraceEnd;
 }
 
+FVector AShooterNPC::CalculateAimDirection(const FVector& AimSource, const FVector& AimForward, bool bHasTarget, const FVector& TargetLocation, float MinOffsetZ, float MaxOffsetZ, float VarianceHalfAngle)
+{
+	// no aim target, so just use the aim source facing
+	if (!bHasTarget)
+	{
+		return UKismetMathLibrary::RandomUnitVectorInConeInDegrees(AimForward, VarianceHalfAngle);
+	}
+
+	// apply a vertical offset to target head/feet
+	FVector AimTarget = TargetLocation;
+	AimTarget.Z += FMath::RandRange(MinOffsetZ, MaxOffsetZ);
+
+	// get the aim direction and apply randomness in a cone
+	const FVector AimDir = (AimTarget - AimSource).GetSafeNormal();
+	return UKismetMathLibrary::RandomUnitVectorInConeInDegrees(AimDir, VarianceHalfAngle);
+}
+
+void AShooterNPC::GetAimSource(FVector& OutLocation, FVector& OutDirection) const
+{
+	// use the camera if we have one
+	if (const UCameraComponent* Camera = GetFirstPersonCameraComponent())
+	{
+		OutLocation = Camera->GetComponentLocation();
+		OutDirection = Camera->GetForwardVector();
+		return;
+	}
+
+	// otherwise aim from eye height
+	OutLocation = GetPawnViewLocation();
+	OutDirection = GetBaseAimRotation().Vector();
+}
+
 void AShooterNPC::AddWeaponClass(const TSubclassOf<AShooterWeapon>& InWeaponClass)
 {
 	// unused
@@ -159,8 +243,11 @@ void AShooterNPC::Die()
 	// raise the dead flag
 	bIsDead = true;
 
+	// drop our pending aim
+	CancelAimRequest();
+
 	// grant the death tag to the character
-	Tags.Add(DeathTag);
+	Tags.AddUnique(DeathTag);
 
 	// call the delegate
 	OnPawnDeath.Broadcast();
@@ -178,10 +265,18 @@ void AShooterNPC::Die()
 	GetCharacterMovement()->StopMovementImmediately();
 	GetCharacterMovement()->StopActiveMovement();
 
-	// enable ragdoll physics on the third person mesh
-	GetMesh()->SetCollisionProfileName(RagdollCollisionProfile);
-	GetMesh()->SetSimulatePhysics(true);
-	GetMesh()->SetPhysicsBlendWeight(1.0f);
+	// ragdoll if the budget allows it, otherwise fall back to a cheaper death
+	UShooterRagdollSubsystem* Ragdolls = GetWorld()->GetSubsystem<UShooterRagdollSubsystem>();
+
+	if (!Ragdolls || Ragdolls->RequestRagdoll(this))
+	{
+		StartRagdoll();
+
+	} else {
+
+		PlayDeathFallback();
+
+	}
 
 	// schedule actor destruction
 	GetWorld()->GetTimerManager().SetTimer(DeathTimer, this, &AShooterNPC::DeferredDestruction, DeferredDestructionTime, false);
@@ -189,9 +284,192 @@ void AShooterNPC::Die()
 
 void AShooterNPC::DeferredDestruction()
 {
+	// return pooled characters to the pool
+	if (bPooled)
+	{
+		if (UShooterNPCPoolSubsystem* Pool = GetWorld()->GetSubsystem<UShooterNPCPoolSubsystem>())
+		{
+			Pool->ReleaseNPC(this);
+			return;
+		}
+	}
+
 	Destroy();
 }
 
+void AShooterNPC::EnterDormantState()
+{
+	// clear the death timers
+	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+	GetWorld()->GetTimerManager().ClearTimer(DeathPoseTimer);
+
+	// release our ragdoll slot
+	if (UShooterRagdollSubsystem* Ragdolls = GetWorld()->GetSubsystem<UShooterRagdollSubsystem>())
+	{
+		Ragdolls->ReleaseRagdoll(this);
+	}
+
+	// stop the ragdoll and the animation
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->SetComponentTickEnabled(false);
+
+	// leave the animation budget so it doesn't spend evaluations on a hidden mesh
+	UnregisterAnimBudget();
+
+	// hide and disable this character
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	// stop and disable movement
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+
+	// pause the kept controller until the character is possessed again
+	if (AShooterAIController* AIController = Cast<AShooterAIController>(DormantController.Get()))
+	{
+		AIController->EnterDormantState();
+	}
+
+	// stop and hide the weapon
+	if (IsValid(Weapon))
+	{
+		Weapon->DeactivateWeapon();
+	}
+}
+
+void AShooterNPC::ResetForReuse(const FTransform& SpawnTransform)
+{
+	// restore the gameplay state
+	CurrentHP = InitialHP;
+	bIsDead = false;
+	bIsShooting = false;
+	CurrentAimTarget = nullptr;
+
+	// remove the death tag
+	Tags.Remove(DeathTag);
+
+	// restore the mesh from the ragdoll or death pose
+	ClearDeathPose();
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->SetPhysicsBlendWeight(0.0f);
+	GetMesh()->SetCollisionProfileName(DefaultMeshCollisionProfile);
+	GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	GetMesh()->SetRelativeLocationAndRotation(GetBaseTranslationOffset(), GetBaseRotationOffset());
+
+	// restore capsule collision
+	GetCapsuleComponent()->SetCollisionEnabled(DefaultCapsuleCollision);
+
+	// move to the spawn point
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	// unhide and enable this character
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	// restore movement
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+
+	// rejoin the animation budget
+	RegisterAnimBudget();
+
+	// refill and show the weapon
+	if (IsValid(Weapon))
+	{
+		Weapon->ResetWeapon();
+		Weapon->ActivateWeapon();
+	}
+}
+
+void AShooterNPC::StartRagdoll()
+{
+	// enable ragdoll physics on the third person mesh
+	GetMesh()->SetCollisionProfileName(RagdollCollisionProfile);
+	GetMesh()->SetSimulatePhysics(true);
+	GetMesh()->SetPhysicsBlendWeight(1.0f);
+}
+
+void AShooterNPC::FreezeDeathPose()
+{
+	USkeletalMeshComponent* ThirdPersonMesh = GetMesh();
+
+	// stop refreshing bones so the mesh holds its current pose
+	ThirdPersonMesh->bNoSkeletonUpdate = true;
+
+	// remove the bodies from the simulation
+	if (ThirdPersonMesh->IsSimulatingPhysics())
+	{
+		ThirdPersonMesh->PutAllRigidBodiesToSleep();
+		ThirdPersonMesh->SetSimulatePhysics(false);
+	}
+
+	// no need to tick a frozen mesh
+	ThirdPersonMesh->SetComponentTickEnabled(false);
+}
+
+void AShooterNPC::PlayDeathFallback()
+{
+	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+
+	// play the death montage and freeze once it's done
+	if (DeathMontage && AnimInstance)
+	{
+		const float MontageLength = AnimInstance->Montage_Play(DeathMontage);
+
+		if (MontageLength > 0.0f)
+		{
+			// freeze just before the montage blends out
+			const float FreezeTime = FMath::Max(MontageLength - DeathMontage->GetDefaultBlendOutTime(), KINDA_SMALL_NUMBER);
+
+			GetWorld()->GetTimerManager().SetTimer(DeathPoseTimer, this, &AShooterNPC::FreezeDeathPose, FreezeTime, false);
+			return;
+		}
+	}
+
+	// no montage, snapshot the current pose
+	FreezeDeathPose();
+}
+
+void AShooterNPC::ClearDeathPose()
+{
+	USkeletalMeshComponent* ThirdPersonMesh = GetMesh();
+
+	// resume bone updates and ticking
+	ThirdPersonMesh->bNoSkeletonUpdate = false;
+	ThirdPersonMesh->SetComponentTickEnabled(true);
+
+	// stop any death montage
+	if (UAnimInstance* AnimInstance = ThirdPersonMesh->GetAnimInstance())
+	{
+		AnimInstance->Montage_Stop(0.0f, DeathMontage);
+	}
+}
+
+void AShooterNPC::RegisterAnimBudget()
+{
+	// nothing is rendered on a dedicated server
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	if (UShooterAnimBudgetSubsystem* AnimBudget = GetWorld()->GetSubsystem<UShooterAnimBudgetSubsystem>())
+	{
+		AnimBudget->RegisterNPC(this);
+	}
+}
+
+void AShooterNPC::UnregisterAnimBudget()
+{
+	if (UShooterAnimBudgetSubsystem* AnimBudget = GetWorld()->GetSubsystem<UShooterAnimBudgetSubsystem>())
+	{
+		AnimBudget->UnregisterNPC(this);
+	}
+}
+
 void AShooterNPC::StartShooting(AActor* ActorToShoot)
 {
 	// save the aim target
@@ -209,6 +487,54 @@ void AShooterNPC::StopShooting()
 	// lower the flag
 	bIsShooting = false;
 
+	// drop our pending aim
+	CancelAimRequest();
+
 	// signal the weapon
 	Weapon->StopFiring();
 }
+
+void AShooterNPC::ScheduleAimRequest()
+{
+	if (!bIsShooting || !IsValid(Weapon))
+	{
+		return;
+	}
+
+	// the batch traces on the frame the request is queued and the result arrives on the next one,
+	// so queue at least two frames before the weapon refires
+	const float LeadTime = FMath::Max(AimRequestLeadTime, 2.0f * GetWorld()->GetDeltaSeconds());
+	const float Delay = Weapon->GetRefireRate() - LeadTime;
+
+	// the weapon refires before a batched result could arrive, so every shot already resolves its aim synchronously
+	if (Delay <= 0.0f)
+	{
+		return;
+	}
+
+	GetWorld()->GetTimerManager().SetTimer(AimRequestTimer, this, &AShooterNPC::QueueAimRequest, Delay, false);
+}
+
+void AShooterNPC::QueueAimRequest()
+{
+	// skip the request if the burst ended and no shot will consume it
+	if (!bIsShooting || !IsValid(Weapon) || !Weapon->IsRefirePending())
+	{
+		return;
+	}
+
+	if (UShooterAimBatchSubsystem* AimBatch = GetWorld()->GetSubsystem<UShooterAimBatchSubsystem>())
+	{
+		AimBatch->QueueAimRequest(this);
+	}
+}
+
+void AShooterNPC::CancelAimRequest()
+{
+	GetWorld()->GetTimerManager().ClearTimer(AimRequestTimer);
+
+	if (UShooterAimBatchSubsystem* AimBatch = GetWorld()->GetSubsystem<UShooterAimBatchSubsystem>())
+	{
+		AimBatch->CancelAimRequest(this);
+	}
+}
@@ -10,6 +10,7 @@
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FPawnDeathDelegate);
 
 class AShooterWeapon;
+class UAnimMontage;
 
 /**
  *  A simple AI-controlled shooter game NPC
@@ -23,6 +24,9 @@ class PROJECTXS_API AShooterNPC : public AProjectXSCharacter, public IShooterWea
 
 public:
 
+	/** Constructor */
+	AShooterNPC(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
 	/** Current HP for this character. It dies if it reaches zero through damage */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Damage")
 	float CurrentHP = 100.0f;
@@ -37,6 +41,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Damage")
 	float DeferredDestructionTime = 5.0f;
 
+	/** Montage to play on death when the ragdoll budget is exhausted. If unset, the current pose is frozen instead */
+	UPROPERTY(EditAnywhere, Category="Damage")
+	UAnimMontage* DeathMontage;
+
 	/** Team byte for this character */
 	UPROPERTY(EditAnywhere, Category="Team")
 	uint8 TeamByte = 1;
@@ -79,6 +87,13 @@ protected:
 	/** Actor currently being targeted */
 	TObjectPtr<AActor> CurrentAimTarget;
 
+	/** Time before the next shot at which its aim is queued in the aim batch, so it's resolved by the time the weapon fires. Never less than two frames */
+	UPROPERTY(EditAnywhere, Category="Aim", meta = (ClampMin = 0, Units = "s"))
+	float AimRequestLeadTime = 0.05f;
+
+	/** Timer to queue the aim for the next shot */
+	FTimerHandle AimRequestTimer;
+
 	/** If true, this character is currently shooting its weapon */
 	bool bIsShooting = false;
 
@@ -88,6 +103,24 @@ protected:
 	/** Deferred destruction on death timer */
 	FTimerHandle DeathTimer;
 
+	/** Timer to freeze the pose at the end of the death montage */
+	FTimerHandle DeathPoseTimer;
+
+	/** If true, this character is owned by the NPC pool and will be recycled instead of destroyed */
+	bool bPooled = false;
+
+	/** Controller kept alive while this character is dormant in the pool */
+	TWeakObjectPtr<AController> DormantController;
+
+	/** HP this character starts with. Restored when recycled */
+	float InitialHP = 100.0f;
+
+	/** Mesh collision profile to restore after ragdoll */
+	FName DefaultMeshCollisionProfile;
+
+	/** Capsule collision mode to restore after death */
+	ECollisionEnabled::Type DefaultCapsuleCollision = ECollisionEnabled::QueryAndPhysics;
+
 public:
 
 	/** Delegate called when this NPC dies */
@@ -144,9 +177,49 @@ protected:
 	/** Called when HP is depleted and the character should die */
 	void Die();
 
-	/** Called after death to destroy the actor */
+	/** Called after death to destroy the actor, or return it to the NPC pool */
 	void DeferredDestruction();
 
+public:
+
+	/** Flags this character as owned by the NPC pool */
+	void SetPooled(bool bInPooled) { bPooled = bInPooled; }
+
+	/** Returns true if this character is owned by the NPC pool */
+	bool IsPooled() const { return bPooled; }
+
+	/** Keeps the controller that should possess this character again when it's recycled */
+	void SetDormantController(AController* InController) { DormantController = InController; }
+
+	/** Returns the controller kept while this character is dormant */
+	AController* GetDormantController() const { return DormantController.Get(); }
+
+	/** Hides and disables this character, its weapon and its kept controller while it waits in the pool */
+	void EnterDormantState();
+
+	/** Brings a dormant character back to life at the given transform */
+	void ResetForReuse(const FTransform& SpawnTransform);
+
+	/** Switches the third person mesh to a simulated ragdoll */
+	void StartRagdoll();
+
+	/** Stops simulating and holds the current death pose */
+	void FreezeDeathPose();
+
+protected:
+
+	/** Plays the death montage, or freezes the pose, when a ragdoll isn't allowed */
+	void PlayDeathFallback();
+
+	/** Undoes any death pose or ragdoll state on the third person mesh */
+	void ClearDeathPose();
+
+	/** Adds this character to the animation budget, unless nothing is rendered */
+	void RegisterAnimBudget();
+
+	/** Removes this character from the animation budget */
+	void UnregisterAnimBudget();
+
 public:
 
 	/** Signals this character to start shooting at the passed actor */
@@ -154,4 +227,41 @@ public:
 
 	/** Signals this character to stop shooting */
 	void StopShooting();
+
+protected:
+
+	/** Schedules the aim request for the weapon's next shot, unless it refires too soon for a batched result */
+	void ScheduleAimRequest();
+
+	/** Queues the aim for the next shot in the aim batch, if the weapon is still going to refire */
+	void QueueAimRequest();
+
+	/** Stops any scheduled or queued aim request */
+	void CancelAimRequest();
+
+public:
+
+	/** Returns the location and direction used as the origin for aiming and line of sight checks */
+	virtual void GetAimSource(FVector& OutLocation, FVector& OutDirection) const;
+
+	/** Returns the actor currently being targeted */
+	AActor* GetCurrentAimTarget() const { return CurrentAimTarget; }
+
+	/** Returns the aim range, cone variance and vertical offset range */
+	void GetAimSettings(float& OutRange, float& OutVarianceHalfAngle, float& OutMinOffsetZ, float& OutMaxOffsetZ) const
+	{
+		OutRange = AimRange;
+		OutVarianceHalfAngle = AimVarianceHalfAngle;
+		OutMinOffsetZ = MinAimOffsetZ;
+		OutMaxOffsetZ = MaxAimOffsetZ;
+	}
+
+	/** Returns a random aim direction towards the target, offset vertically and spread in a cone. Aims along the forward vector if there's no target */
+	static FVector CalculateAimDirection(const FVector& AimSource, const FVector& AimForward, bool bHasTarget, const FVector& TargetLocation, float MinOffsetZ, float MaxOffsetZ, float VarianceHalfAngle);
+
+	/** Returns true if this character has already died */
+	bool IsDead() const { return bIsDead; }
+
+	/** Returns the team byte for this character */
+	uint8 GetTeamByte() const { return TeamByte; }
 };
@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterNPCPoolSubsystem.h"
+#include "ShooterNPC.h"
+#include "GameFramework/Controller.h"
+#include "Engine/World.h"
+
+AShooterNPC* UShooterNPCPoolSubsystem::AcquireNPC(TSubclassOf<AShooterNPC> NPCClass, const FTransform& SpawnTransform)
+{
+	if (!IsValid(NPCClass))
+	{
+		return nullptr;
+	}
+
+	// try to recycle a dormant NPC first
+	if (AShooterNPC* RecycledNPC = PopDormantNPC(NPCClass))
+	{
+		RecycledNPC->ResetForReuse(SpawnTransform);
+
+		// possess it again with the controller it kept, or a fresh one if it was lost
+		if (AController* DormantController = RecycledNPC->GetDormantController())
+		{
+			RecycledNPC->SetDormantController(nullptr);
+			DormantController->Possess(RecycledNPC);
+
+		} else {
+
+			RecycledNPC->SpawnDefaultController();
+
+		}
+
+		return RecycledNPC;
+	}
+
+	// spawn a new NPC for the pool
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AShooterNPC* SpawnedNPC = GetWorld()->SpawnActor<AShooterNPC>(NPCClass, SpawnTransform, SpawnParams);
+
+	if (SpawnedNPC)
+	{
+		SpawnedNPC->SetPooled(true);
+	}
+
+	return SpawnedNPC;
+}
+
+void UShooterNPCPoolSubsystem::ReleaseNPC(AShooterNPC* NPC)
+{
+	if (!IsValid(NPC))
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<AShooterNPC>>& Dormant = DormantNPCs.FindOrAdd(NPC->GetClass());
+
+	// is the pool for this class full?
+	if (Dormant.Num() >= MaxDormantPerClass)
+	{
+		if (AController* DormantController = NPC->GetDormantController())
+		{
+			DormantController->Destroy();
+		}
+
+		NPC->Destroy();
+		return;
+	}
+
+	// drop any death subscribers from the previous life
+	NPC->OnPawnDeath.Clear();
+
+	NPC->EnterDormantState();
+
+	Dormant.Add(NPC);
+}
+
+int32 UShooterNPCPoolSubsystem::GetNumDormant(TSubclassOf<AShooterNPC> NPCClass) const
+{
+	const TArray<TWeakObjectPtr<AShooterNPC>>* Dormant = DormantNPCs.Find(NPCClass.Get());
+	return Dormant ? Dormant->Num() : 0;
+}
+
+AShooterNPC* UShooterNPCPoolSubsystem::PopDormantNPC(UClass* NPCClass)
+{
+	TArray<TWeakObjectPtr<AShooterNPC>>* Dormant = DormantNPCs.Find(NPCClass);
+
+	if (!Dormant)
+	{
+		return nullptr;
+	}
+
+	// skip any NPCs that were destroyed while dormant
+	while (Dormant->Num() > 0)
+	{
+		if (AShooterNPC* NPC = Dormant->Pop(EAllowShrinking::No).Get())
+		{
+			return NPC;
+		}
+	}
+
+	return nullptr;
+}
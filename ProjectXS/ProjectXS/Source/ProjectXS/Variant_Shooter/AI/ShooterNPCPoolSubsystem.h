@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterNPCPoolSubsystem.generated.h"
+
+class AShooterNPC;
+
+/**
+ *  Shared pool of dormant NPCs for the shooter game
+ *  Each pooled NPC keeps its AI Controller and weapon, so recycling an NPC
+ *  doesn't spawn any actors once the pool is warm
+ */
+UCLASS(config="Game")
+class PROJECTXS_API UShooterNPCPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Max number of dormant NPCs kept per class. Extra released NPCs are destroyed */
+	UPROPERTY(Config)
+	int32 MaxDormantPerClass = 32;
+
+	/** Dormant NPCs, grouped by class */
+	TMap<TObjectKey<UClass>, TArray<TWeakObjectPtr<AShooterNPC>>> DormantNPCs;
+
+public:
+
+	/** Returns a live NPC of the given class at the transform, recycling a dormant one if possible */
+	AShooterNPC* AcquireNPC(TSubclassOf<AShooterNPC> NPCClass, const FTransform& SpawnTransform);
+
+	/** Returns a dead NPC to the pool */
+	void ReleaseNPC(AShooterNPC* NPC);
+
+	/** Returns the number of dormant NPCs of the given class */
+	int32 GetNumDormant(TSubclassOf<AShooterNPC> NPCClass) const;
+
+protected:
+
+	/** Pops the next valid dormant NPC of the given class */
+	AShooterNPC* PopDormantNPC(UClass* NPCClass);
+};
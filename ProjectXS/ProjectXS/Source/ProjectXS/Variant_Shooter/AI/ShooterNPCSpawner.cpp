@@ -8,6 +8,7 @@
 #include "Components/ArrowComponent.h"
 #include "TimerManager.h"
 #include "ShooterNPC.h"
+#include "ShooterNPCPoolSubsystem.h"
 
 // Sets default values
 AShooterNPCSpawner::AShooterNPCSpawner()
@@ -33,8 +34,8 @@ void AShooterNPCSpawner::BeginPlay()
 {
 	Super::BeginPlay();
 	
-	// ensure we don't spawn NPCs if our initial spawn count is zero
-	if (SpawnCount > 0)
+	// ensure we don't spawn NPCs if our initial spawn count is zero or spawning was disabled
+	if (SpawnCount > 0 && !bSpawningDisabled)
 	{
 		// schedule the first NPC spawn
 		GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &AShooterNPCSpawner::SpawnNPC, InitialSpawnDelay);
@@ -49,22 +50,35 @@ void AShooterNPCSpawner::EndPlay(EEndPlayReason::Type EndPlayReason)
 	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
 }
 
+FTransform AShooterNPCSpawner::GetSpawnTransform() const
+{
+	// use the reference capsule's transform
+	return SpawnCapsule->GetComponentTransform();
+}
+
+void AShooterNPCSpawner::DisableSpawning()
+{
+	bSpawningDisabled = true;
+
+	// cancel any pending spawn
+	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
+}
+
 void AShooterNPCSpawner::SpawnNPC()
 {
 	// ensure the NPC class is valid
-	if (IsValid(NPCClass))
-	{
-		// spawn the NPC at the reference capsule's transform
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	UShooterNPCPoolSubsystem* Pool = GetWorld()->GetSubsystem<UShooterNPCPoolSubsystem>();
 
-		AShooterNPC* SpawnedNPC = GetWorld()->SpawnActor<AShooterNPC>(NPCClass, SpawnCapsule->GetComponentTransform(), SpawnParams);
+	if (IsValid(NPCClass) && Pool)
+	{
+		// get an NPC from the pool at the reference capsule's transform
+		AShooterNPC* SpawnedNPC = Pool->AcquireNPC(NPCClass, GetSpawnTransform());
 
 		// was the NPC successfully created?
 		if (SpawnedNPC)
 		{
 			// subscribe to the death delegate
-			SpawnedNPC->OnPawnDeath.AddDynamic(this, &AShooterNPCSpawner::OnNPCDied);
+			SpawnedNPC->OnPawnDeath.AddUniqueDynamic(this, &AShooterNPCSpawner::OnNPCDied);
 		}
 	}
 }
@@ -74,8 +88,8 @@ void AShooterNPCSpawner::OnNPCDied()
 	// decrease the spawn counter
 	--SpawnCount;
 
-	// is this the last NPC we should spawn?
-	if (SpawnCount <= 0)
+	// is this the last NPC we should spawn, or was spawning disabled?
+	if (SpawnCount <= 0 || bSpawningDisabled)
 	{
 		return;
 	}
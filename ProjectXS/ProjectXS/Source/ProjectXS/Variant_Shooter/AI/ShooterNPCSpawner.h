@@ -46,6 +46,9 @@ protected:
 	/** Timer to spawn NPCs after a delay */
 	FTimerHandle SpawnTimer;
 
+	/** If true, the spawner doesn't schedule any spawns */
+	bool bSpawningDisabled = false;
+
 public:	
 	
 	/** Constructor */
@@ -59,6 +62,15 @@ public:
 	/** Cleanup */
 	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 
+	/** Returns the type of NPC this spawner creates */
+	TSubclassOf<AShooterNPC> GetNPCClass() const { return NPCClass; }
+
+	/** Returns the transform NPCs are spawned at */
+	FTransform GetSpawnTransform() const;
+
+	/** Cancels any scheduled spawn and stops the spawner from scheduling new ones */
+	void DisableSpawning();
+
 protected:
 
 	/** Spawn an NPC and subscribe to its death event */
@@ -0,0 +1,279 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterPathBrokerSubsystem.h"
+#include "ShooterAIController.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Engine/World.h"
+
+int32 UShooterPathBrokerSubsystem::RequestPath(AShooterAIController* Controller, const FVector& Goal, float AcceptanceRadius, const FShooterPathReadyDelegate& OnPathReady)
+{
+	if (!IsValid(Controller) || !Controller->GetPawn())
+	{
+		return INDEX_NONE;
+	}
+
+	FPathWaiter NewWaiter;
+	NewWaiter.RequestId = ++LastRequestId;
+	NewWaiter.Controller = Controller;
+	NewWaiter.Start = Controller->GetNavAgentLocation();
+	NewWaiter.Goal = Goal;
+	NewWaiter.AcceptanceRadius = AcceptanceRadius;
+	NewWaiter.OnPathReady = OnPathReady;
+
+	FPathKey Key(GetCell(NewWaiter.Start), GetCell(Goal), 0);
+
+	// share the query with NPCs going between the same points, give everyone else in those cells a query of their own
+	FPathQuery* Query = Queries.Find(Key);
+
+	if (Query && !CanSharePath(NewWaiter, Query->Start, Query->Goal))
+	{
+		Key.Get<2>() = ++LastUnsharedKey;
+		Query = nullptr;
+	}
+
+	if (!Query)
+	{
+		Query = &Queries.Add(Key);
+		Query->Start = NewWaiter.Start;
+		Query->Goal = Goal;
+
+		QueuedKeys.Add(Key);
+	}
+
+	// the delegate is always called later from our tick, so the caller can store the id first
+	Query->Waiters.Add(MoveTemp(NewWaiter));
+
+	return LastRequestId;
+}
+
+void UShooterPathBrokerSubsystem::CancelRequest(int32 RequestId)
+{
+	for (TPair<FPathKey, FPathQuery>& Pair : Queries)
+	{
+		if (Pair.Value.Waiters.RemoveAll([RequestId](const FPathWaiter& Waiter) { return Waiter.RequestId == RequestId; }) > 0)
+		{
+			// queries that were never started and lost all their waiters are dropped on the next tick.
+			// Running ones are left to complete so their result still gets cached
+			return;
+		}
+	}
+}
+
+void UShooterPathBrokerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// expire old paths
+	for (auto It = PathCache.CreateIterator(); It; ++It)
+	{
+		if (It.Value().ExpireTime <= Now)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	int32 NumStarted = 0;
+
+	for (int32 i = 0; i < QueuedKeys.Num(); )
+	{
+		const FPathKey Key = QueuedKeys[i];
+		FPathQuery* Query = Queries.Find(Key);
+
+		// everyone waiting on this query gave up
+		if (!Query || Query->Waiters.IsEmpty())
+		{
+			Queries.Remove(Key);
+			QueuedKeys.RemoveAt(i);
+			continue;
+		}
+
+		// a recent search covers the waiters close enough to its start and goal
+		if (const FCachedPath* Cached = PathCache.Find(FPathCells(Key.Get<0>(), Key.Get<1>())))
+		{
+			TArray<FPathWaiter> Covered;
+
+			for (int32 WaiterIndex = Query->Waiters.Num() - 1; WaiterIndex >= 0; --WaiterIndex)
+			{
+				if (CanSharePath(Query->Waiters[WaiterIndex], Cached->Start, Cached->Goal))
+				{
+					Covered.Add(MoveTemp(Query->Waiters[WaiterIndex]));
+					Query->Waiters.RemoveAt(WaiterIndex);
+				}
+			}
+
+			const FNavPathSharedPtr CachedPath = Cached->Path;
+			const bool bAllCovered = Query->Waiters.IsEmpty();
+
+			if (bAllCovered)
+			{
+				Queries.Remove(Key);
+				QueuedKeys.RemoveAt(i);
+			}
+
+			DeliverPath(Covered, CachedPath);
+
+			if (bAllCovered)
+			{
+				continue;
+			}
+
+			// the query pointer may have been invalidated by requests made from the delegates
+			Query = Queries.Find(Key);
+
+			if (!Query)
+			{
+				continue;
+			}
+		}
+
+		// out of budget for this frame, keep it queued
+		if (NumStarted >= MaxQueriesStartedPerTick || NumQueriesInFlight >= MaxQueriesInFlight)
+		{
+			++i;
+			continue;
+		}
+
+		QueuedKeys.RemoveAt(i);
+
+		if (StartQuery(Key, *Query))
+		{
+			++NumStarted;
+			++NumQueriesInFlight;
+
+		} else {
+
+			FPathQuery Failed = MoveTemp(*Query);
+			Queries.Remove(Key);
+
+			DeliverPath(Failed.Waiters, nullptr);
+		}
+	}
+}
+
+TStatId UShooterPathBrokerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterPathBrokerSubsystem, STATGROUP_Tickables);
+}
+
+bool UShooterPathBrokerSubsystem::StartQuery(const FPathKey& Key, FPathQuery& Query)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	// use the first waiter still around as the querier
+	const FPathWaiter* Querier = Query.Waiters.FindByPredicate([](const FPathWaiter& Waiter) { return Waiter.Controller.IsValid(); });
+
+	if (!NavSys || !Querier)
+	{
+		return false;
+	}
+
+	AShooterAIController* Controller = Querier->Controller.Get();
+	const FNavAgentProperties& AgentProperties = Controller->GetNavAgentPropertiesRef();
+	const ANavigationData* NavData = NavSys->GetNavDataForProps(AgentProperties, Query.Start);
+
+	if (!NavData)
+	{
+		return false;
+	}
+
+	const FPathFindingQuery PathQuery(Controller, *NavData, Query.Start, Query.Goal, UNavigationQueryFilter::GetQueryFilter(*NavData, Controller, nullptr));
+
+	// the search runs on the navigation worker threads and calls us back on the game thread
+	Query.NavQueryId = NavSys->FindPathAsync(AgentProperties, PathQuery, FNavPathQueryDelegate::CreateUObject(this, &UShooterPathBrokerSubsystem::OnQueryFinished, Key), EPathFindingMode::Regular);
+	Query.bStarted = Query.NavQueryId != INVALID_NAVQUERYID;
+
+	return Query.bStarted;
+}
+
+void UShooterPathBrokerSubsystem::OnQueryFinished(uint32 NavQueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, FPathKey Key)
+{
+	--NumQueriesInFlight;
+
+	FPathQuery Query;
+
+	if (!Queries.RemoveAndCopyValue(Key, Query))
+	{
+		return;
+	}
+
+	const bool bSuccess = Result == ENavigationQueryResult::Success && Path.IsValid() && Path->IsValid();
+
+	// cache the path for the NPCs following shortly after
+	if (bSuccess)
+	{
+		FCachedPath& Cached = PathCache.Add(FPathCells(Key.Get<0>(), Key.Get<1>()));
+		Cached.Path = Path;
+		Cached.Start = Query.Start;
+		Cached.Goal = Query.Goal;
+		Cached.ExpireTime = GetWorld()->GetTimeSeconds() + CacheLifetime;
+	}
+
+	DeliverPath(Query.Waiters, bSuccess ? Path : nullptr);
+}
+
+void UShooterPathBrokerSubsystem::DeliverPath(TArray<FPathWaiter>& Waiters, FNavPathSharedPtr Path) const
+{
+	for (FPathWaiter& Waiter : Waiters)
+	{
+		AShooterAIController* Controller = Waiter.Controller.Get();
+
+		if (!IsValid(Controller))
+		{
+			continue;
+		}
+
+		// every NPC gets its own copy, since path following modifies the path it's given
+		Waiter.OnPathReady.ExecuteIfBound(CopyPathFor(Path, Controller));
+	}
+}
+
+bool UShooterPathBrokerSubsystem::CanSharePath(const FPathWaiter& Waiter, const FVector& Start, const FVector& Goal)
+{
+	// the waiter's first and last legs to the shared path aren't validated, so keep them short
+	const float MaxDistSquared = FMath::Square(Waiter.AcceptanceRadius);
+
+	return FVector::DistSquared(Waiter.Start, Start) <= MaxDistSquared && FVector::DistSquared(Waiter.Goal, Goal) <= MaxDistSquared;
+}
+
+FNavPathSharedPtr UShooterPathBrokerSubsystem::CopyPathFor(const FNavPathSharedPtr& Path, AShooterAIController* Controller)
+{
+	if (!Path.IsValid() || !Controller)
+	{
+		return nullptr;
+	}
+
+	TArray<FVector> Points;
+	Points.Reserve(Path->GetPathPoints().Num());
+
+	for (const FNavPathPoint& PathPoint : Path->GetPathPoints())
+	{
+		Points.Add(PathPoint.Location);
+	}
+
+	// start from this NPC rather than whoever the path was found for, they're within the acceptance radius.
+	// The end is left alone, so partial paths keep ending where the navmesh does
+	if (Points.Num() > 0)
+	{
+		Points[0] = Controller->GetNavAgentLocation();
+	}
+
+	FNavPathSharedPtr NewPath = MakeShared<FNavigationPath, ESPMode::ThreadSafe>(Points);
+	NewPath->SetNavigationDataUsed(Path->GetNavigationDataUsed());
+	NewPath->SetQuerier(Controller);
+	NewPath->SetIsPartial(Path->IsPartial());
+
+	return NewPath;
+}
+
+FIntVector UShooterPathBrokerSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / PathCellSize),
+		FMath::FloorToInt32(Location.Y / PathCellSize),
+		FMath::FloorToInt32(Location.Z / PathCellSize));
+}
@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "ShooterPathBrokerSubsystem.generated.h"
+
+class AShooterAIController;
+class ANavigationData;
+
+DECLARE_DELEGATE_OneParam(FShooterPathReadyDelegate, FNavPathSharedPtr);
+
+/**
+ *  Finds navigation paths for the shooter NPCs
+ *  Requests are queued and run asynchronously on the navigation worker threads, a few per frame.
+ *  Requests whose start and goal are within the acceptance radius of an existing query share it,
+ *  and recent results are cached for a short time so a spawning wave doesn't run the same search over and over
+ */
+UCLASS(config="Game")
+class PROJECTXS_API UShooterPathBrokerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Start and goal cells for a path */
+	using FPathCells = TTuple<FIntVector, FIntVector>;
+
+	/** Start and goal cells for a query, and a discriminator for queries between the same cells that can't be shared */
+	using FPathKey = TTuple<FIntVector, FIntVector, int32>;
+
+	/** NPC waiting for a path */
+	struct FPathWaiter
+	{
+		int32 RequestId = INDEX_NONE;
+		TWeakObjectPtr<AShooterAIController> Controller;
+		FVector Start = FVector::ZeroVector;
+		FVector Goal = FVector::ZeroVector;
+		float AcceptanceRadius = 0.0f;
+		FShooterPathReadyDelegate OnPathReady;
+	};
+
+	/** Path query shared by every waiter close enough to its start and goal */
+	struct FPathQuery
+	{
+		FVector Start = FVector::ZeroVector;
+		FVector Goal = FVector::ZeroVector;
+		TArray<FPathWaiter> Waiters;
+		uint32 NavQueryId = 0;
+		bool bStarted = false;
+	};
+
+	/** Cached path result */
+	struct FCachedPath
+	{
+		FNavPathSharedPtr Path;
+		FVector Start = FVector::ZeroVector;
+		FVector Goal = FVector::ZeroVector;
+		double ExpireTime = 0.0;
+	};
+
+protected:
+
+	/** Max number of async path queries started each frame */
+	UPROPERTY(Config)
+	int32 MaxQueriesStartedPerTick = 4;
+
+	/** Max number of async path queries running at the same time */
+	UPROPERTY(Config)
+	int32 MaxQueriesInFlight = 8;
+
+	/** Size of the cells used to share paths between NPCs */
+	UPROPERTY(Config)
+	float PathCellSize = 200.0f;
+
+	/** Time a found path stays in the cache */
+	UPROPERTY(Config)
+	float CacheLifetime = 2.0f;
+
+	/** Queued and running queries */
+	TMap<FPathKey, FPathQuery> Queries;
+
+	/** Keys of the queries waiting to be started, in request order */
+	TArray<FPathKey> QueuedKeys;
+
+	/** Recently found paths */
+	TMap<FPathCells, FCachedPath> PathCache;
+
+	/** Number of queries currently running */
+	int32 NumQueriesInFlight = 0;
+
+	/** Last request id handed out */
+	int32 LastRequestId = 0;
+
+	/** Last discriminator handed out to a query that couldn't be shared */
+	int32 LastUnsharedKey = 0;
+
+public:
+
+	/** Queues a path request for an NPC. Paths found for other NPCs are only reused if their start and goal are within the acceptance radius. The delegate receives a null path if none could be found. Returns the request id */
+	int32 RequestPath(AShooterAIController* Controller, const FVector& Goal, float AcceptanceRadius, const FShooterPathReadyDelegate& OnPathReady);
+
+	/** Cancels a path request without calling its delegate */
+	void CancelRequest(int32 RequestId);
+
+	//~Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return Queries.Num() > 0 || PathCache.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	//~End FTickableGameObject interface
+
+protected:
+
+	/** Starts an async path query. Returns false if it couldn't be started */
+	bool StartQuery(const FPathKey& Key, FPathQuery& Query);
+
+	/** Called on the game thread when an async path query completes */
+	void OnQueryFinished(uint32 NavQueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, FPathKey Key);
+
+	/** Hands a path to every waiter in the list */
+	void DeliverPath(TArray<FPathWaiter>& Waiters, FNavPathSharedPtr Path) const;
+
+	/** Returns true if a waiter can follow a path found between the given start and goal */
+	static bool CanSharePath(const FPathWaiter& Waiter, const FVector& Start, const FVector& Goal);
+
+	/** Returns a copy of a path starting at the controller's location */
+	static FNavPathSharedPtr CopyPathFor(const FNavPathSharedPtr& Path, AShooterAIController* Controller);
+
+	/** Returns the cell containing a location */
+	FIntVector GetCell(const FVector& Location) const;
+};
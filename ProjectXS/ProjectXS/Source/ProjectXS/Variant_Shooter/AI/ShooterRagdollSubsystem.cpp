@@ -0,0 +1,146 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterRagdollSubsystem.h"
+#include "ShooterNPC.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+bool UShooterRagdollSubsystem::RequestRagdoll(AShooterNPC* NPC)
+{
+	if (!IsValid(NPC))
+	{
+		return false;
+	}
+
+	const float Priority = GetRagdollPriority(NPC);
+
+	// do we have a free slot?
+	if (ActiveRagdolls.Num() >= MaxSimulatedRagdolls)
+	{
+		// find the least important ragdoll that has come to rest.
+		// freezing a falling ragdoll would leave it hanging mid-air
+		int32 LowestIndex = INDEX_NONE;
+		float LowestPriority = TNumericLimits<float>::Max();
+
+		for (int32 i = 0; i < ActiveRagdolls.Num(); ++i)
+		{
+			const AShooterNPC* ActiveNPC = ActiveRagdolls[i].NPC.Get();
+
+			if (IsValid(ActiveNPC) && !IsRagdollSettled(ActiveNPC))
+			{
+				continue;
+			}
+
+			if (ActiveRagdolls[i].Priority < LowestPriority)
+			{
+				LowestPriority = ActiveRagdolls[i].Priority;
+				LowestIndex = i;
+			}
+		}
+
+		// the new ragdoll isn't more important than any resting one
+		if (LowestIndex == INDEX_NONE || LowestPriority >= Priority)
+		{
+			return false;
+		}
+
+		// evict the least important ragdoll
+		if (AShooterNPC* EvictedNPC = ActiveRagdolls[LowestIndex].NPC.Get())
+		{
+			EvictedNPC->FreezeDeathPose();
+		}
+
+		ActiveRagdolls.RemoveAtSwap(LowestIndex);
+	}
+
+	FActiveRagdoll& NewRagdoll = ActiveRagdolls.AddDefaulted_GetRef();
+	NewRagdoll.NPC = NPC;
+	NewRagdoll.StartTime = GetWorld()->GetTimeSeconds();
+	NewRagdoll.Priority = Priority;
+
+	return true;
+}
+
+void UShooterRagdollSubsystem::ReleaseRagdoll(AShooterNPC* NPC)
+{
+	ActiveRagdolls.RemoveAllSwap([NPC](const FActiveRagdoll& Ragdoll)
+	{
+		return Ragdoll.NPC == NPC;
+	});
+}
+
+void UShooterRagdollSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	for (int32 i = ActiveRagdolls.Num() - 1; i >= 0; --i)
+	{
+		FActiveRagdoll& Ragdoll = ActiveRagdolls[i];
+		AShooterNPC* NPC = Ragdoll.NPC.Get();
+
+		// drop ragdolls that are gone or no longer simulating
+		if (!IsValid(NPC) || !NPC->GetMesh()->IsSimulatingPhysics())
+		{
+			ActiveRagdolls.RemoveAtSwap(i);
+			continue;
+		}
+
+		// has the ragdoll come to rest?
+		Ragdoll.SettledTime = IsRagdollSettled(NPC) ? Ragdoll.SettledTime + DeltaTime : 0.0f;
+
+		// freeze settled or expired ragdolls and free their slot
+		if (Ragdoll.SettledTime >= SettleTime || Now - Ragdoll.StartTime >= MaxSimulationTime)
+		{
+			NPC->FreezeDeathPose();
+			ActiveRagdolls.RemoveAtSwap(i);
+		}
+	}
+}
+
+TStatId UShooterRagdollSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterRagdollSubsystem, STATGROUP_Tickables);
+}
+
+bool UShooterRagdollSubsystem::IsRagdollSettled(const AShooterNPC* NPC) const
+{
+	USkeletalMeshComponent* Mesh = NPC->GetMesh();
+
+	// sleeping or slower than the settle speed
+	return !Mesh->RigidBodyIsAwake() || Mesh->GetPhysicsLinearVelocity().SizeSquared() < FMath::Square(SettleSpeed);
+}
+
+float UShooterRagdollSubsystem::GetRagdollPriority(const AShooterNPC* NPC) const
+{
+	const FVector NPCLocation = NPC->GetActorLocation();
+
+	// find the closest player viewpoint
+	float ClosestDistance = PriorityDistance;
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PC = It->Get())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+			ClosestDistance = FMath::Min(ClosestDistance, static_cast<float>(FVector::Dist(ViewLocation, NPCLocation)));
+		}
+	}
+
+	// closer ragdolls are more important
+	float Priority = 1.0f - (ClosestDistance / FMath::Max(PriorityDistance, 1.0f));
+
+	// visible ragdolls are more important
+	if (NPC->GetMesh()->WasRecentlyRendered(0.2f))
+	{
+		Priority += VisibilityPriority;
+	}
+
+	return Priority;
+}
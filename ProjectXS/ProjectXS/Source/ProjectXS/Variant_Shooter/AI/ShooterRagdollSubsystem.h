@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterRagdollSubsystem.generated.h"
+
+class AShooterNPC;
+
+/**
+ *  Budgets simulated death ragdolls for shooter NPCs
+ *  Caps the number of concurrent ragdolls, gives the slots to the NPCs closest to and visible by players,
+ *  and freezes ragdolls early once they settle
+ */
+UCLASS(config="Game")
+class PROJECTXS_API UShooterRagdollSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Ragdoll currently using a simulation slot */
+	struct FActiveRagdoll
+	{
+		/** NPC owning the ragdoll */
+		TWeakObjectPtr<AShooterNPC> NPC;
+
+		/** Time the ragdoll started simulating */
+		double StartTime = 0.0;
+
+		/** Time the ragdoll has been below the settle speed */
+		float SettledTime = 0.0f;
+
+		/** Priority the slot was granted with */
+		float Priority = 0.0f;
+	};
+
+protected:
+
+	/** Max number of ragdolls simulating at the same time */
+	UPROPERTY(Config)
+	int32 MaxSimulatedRagdolls = 4;
+
+	/** Max time a ragdoll can simulate before it's frozen */
+	UPROPERTY(Config)
+	float MaxSimulationTime = 4.0f;
+
+	/** Speed under which a ragdoll is considered settled */
+	UPROPERTY(Config)
+	float SettleSpeed = 15.0f;
+
+	/** Time a ragdoll must stay settled before it's frozen */
+	UPROPERTY(Config)
+	float SettleTime = 0.5f;
+
+	/** Distance at which a ragdoll loses all distance priority */
+	UPROPERTY(Config)
+	float PriorityDistance = 5000.0f;
+
+	/** Priority bonus for ragdolls that were rendered recently */
+	UPROPERTY(Config)
+	float VisibilityPriority = 1.0f;
+
+	/** Ragdolls using a simulation slot */
+	TArray<FActiveRagdoll> ActiveRagdolls;
+
+public:
+
+	/** Asks for a ragdoll slot for a dying NPC. May evict a lower priority ragdoll that has come to rest. Returns false if over budget */
+	bool RequestRagdoll(AShooterNPC* NPC);
+
+	/** Frees the NPC's ragdoll slot, if it has one */
+	void ReleaseRagdoll(AShooterNPC* NPC);
+
+	/** Returns the number of ragdolls currently simulating */
+	int32 GetNumActiveRagdolls() const { return ActiveRagdolls.Num(); }
+
+	//~Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return ActiveRagdolls.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	//~End FTickableGameObject interface
+
+protected:
+
+	/** Returns true if the NPC's ragdoll is asleep or moving slower than the settle speed */
+	bool IsRagdollSettled(const AShooterNPC* NPC) const;
+
+	/** Returns how important it is for the NPC to ragdoll, based on distance and visibility to players */
+	float GetRagdollPriority(const AShooterNPC* NPC) const;
+};
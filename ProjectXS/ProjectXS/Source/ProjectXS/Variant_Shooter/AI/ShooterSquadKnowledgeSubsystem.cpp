@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterSquadKnowledgeSubsystem.h"
+#include "Engine/World.h"
+
+void UShooterSquadKnowledgeSubsystem::ReportSighting(uint8 TeamByte, AActor* Target, const FVector& SpotterLocation)
+{
+	if (!IsValid(Target))
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	FTeamKnowledge& Knowledge = KnowledgeByTeam.FindOrAdd(TeamByte);
+
+	// drop the expired sightings while we're here
+	Knowledge.Sightings.RemoveAllSwap([this, Now](const FShooterSquadSighting& Sighting)
+	{
+		return !IsSightingValid(Sighting, Now);
+	});
+
+	// keep a single sighting per target
+	FShooterSquadSighting* Sighting = Knowledge.Sightings.FindByPredicate([Target](const FShooterSquadSighting& Existing)
+	{
+		return Existing.Target == Target;
+	});
+
+	if (!Sighting)
+	{
+		Sighting = &Knowledge.Sightings.AddDefaulted_GetRef();
+		Sighting->Target = Target;
+	}
+
+	Sighting->TargetLocation = Target->GetActorLocation();
+	Sighting->SpotterLocation = SpotterLocation;
+	Sighting->Time = Now;
+}
+
+bool UShooterSquadKnowledgeSubsystem::CanSkipLineOfSight(uint8 TeamByte, const AActor* Target, const FVector& EyeLocation) const
+{
+	const FTeamKnowledge* Knowledge = KnowledgeByTeam.Find(TeamByte);
+
+	if (!Knowledge)
+	{
+		return false;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	for (const FShooterSquadSighting& Sighting : Knowledge->Sightings)
+	{
+		if (Sighting.Target == Target)
+		{
+			// only trust very fresh sightings traced from almost our own viewpoint to almost where the target is now,
+			// so our trace would run right next to the clear one. Anything else is only a last known position
+			const float SkipTraceRadiusSquared = FMath::Square(SkipTraceRadius);
+
+			return Now - Sighting.Time <= SkipTraceMaxAge
+				&& FVector::DistSquared(Sighting.SpotterLocation, EyeLocation) <= SkipTraceRadiusSquared
+				&& FVector::DistSquared(Sighting.TargetLocation, Target->GetActorLocation()) <= SkipTraceRadiusSquared;
+		}
+	}
+
+	return false;
+}
+
+bool UShooterSquadKnowledgeSubsystem::GetSharedSighting(uint8 TeamByte, const FVector& Location, FShooterSquadSighting& OutSighting) const
+{
+	const FTeamKnowledge* Knowledge = KnowledgeByTeam.Find(TeamByte);
+
+	if (!Knowledge)
+	{
+		return false;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const FShooterSquadSighting* Best = nullptr;
+
+	for (const FShooterSquadSighting& Sighting : Knowledge->Sightings)
+	{
+		if (!IsSightingValid(Sighting, Now) || FVector::DistSquared(Sighting.SpotterLocation, Location) > FMath::Square(ShareRadius))
+		{
+			continue;
+		}
+
+		if (!Best || Sighting.Time > Best->Time)
+		{
+			Best = &Sighting;
+		}
+	}
+
+	if (!Best)
+	{
+		return false;
+	}
+
+	OutSighting = *Best;
+	return true;
+}
+
+float UShooterSquadKnowledgeSubsystem::GetSightingConfidence(const FShooterSquadSighting& Sighting) const
+{
+	const double Age = GetWorld()->GetTimeSeconds() - Sighting.Time;
+	return 1.0f - FMath::Clamp(static_cast<float>(Age) / SightingLifetime, 0.0f, 1.0f);
+}
+
+bool UShooterSquadKnowledgeSubsystem::IsSightingValid(const FShooterSquadSighting& Sighting, double Now) const
+{
+	return Sighting.Target.IsValid() && Now - Sighting.Time <= SightingLifetime;
+}
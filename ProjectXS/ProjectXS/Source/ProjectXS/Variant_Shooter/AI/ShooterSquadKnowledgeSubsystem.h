@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterSquadKnowledgeSubsystem.generated.h"
+
+/**
+ *  Confirmed line of sight sighting of a target, shared with the spotter's team
+ */
+struct FShooterSquadSighting
+{
+	/** Sighted actor */
+	TWeakObjectPtr<AActor> Target;
+
+	/** Where the target was seen */
+	FVector TargetLocation = FVector::ZeroVector;
+
+	/** Where the spotter's line of sight trace started */
+	FVector SpotterLocation = FVector::ZeroVector;
+
+	/** Time of the sighting */
+	double Time = 0.0;
+};
+
+/**
+ *  Shares confirmed sightings between NPCs on the same team
+ *  Once an NPC traces line of sight to a target, nearby teammates can reuse that sighting
+ *  instead of tracing to the same target themselves. Sightings decay over time
+ */
+UCLASS(config="Game")
+class PROJECTXS_API UShooterSquadKnowledgeSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Sightings for one team */
+	struct FTeamKnowledge
+	{
+		TArray<FShooterSquadSighting> Sightings;
+	};
+
+protected:
+
+	/** Time after which a sighting is forgotten */
+	UPROPERTY(Config)
+	float SightingLifetime = 5.0f;
+
+	/** Max distance between the spotter and a teammate for the teammate to receive the sighting */
+	UPROPERTY(Config)
+	float ShareRadius = 2500.0f;
+
+	/** Max age of a sighting for a teammate to skip its own line of sight trace */
+	UPROPERTY(Config)
+	float SkipTraceMaxAge = 0.5f;
+
+	/** Max offset of a teammate's eyes from the spotter's, and of the target from where it was seen, for the teammate to skip its own trace */
+	UPROPERTY(Config)
+	float SkipTraceRadius = 100.0f;
+
+	/** Knowledge for each team */
+	TMap<uint8, FTeamKnowledge> KnowledgeByTeam;
+
+public:
+
+	/** Shares a confirmed sighting with the team */
+	void ReportSighting(uint8 TeamByte, AActor* Target, const FVector& SpotterLocation);
+
+	/** Returns true if a teammate saw the target recently from nearly the same eye location, with the target nearly where it was */
+	bool CanSkipLineOfSight(uint8 TeamByte, const AActor* Target, const FVector& EyeLocation) const;
+
+	/** Finds the freshest sighting shared by a teammate within range of the location. Returns false if there's none */
+	bool GetSharedSighting(uint8 TeamByte, const FVector& Location, FShooterSquadSighting& OutSighting) const;
+
+	/** Returns how much a sighting can still be trusted, from 1 when fresh to 0 when forgotten */
+	float GetSightingConfidence(const FShooterSquadSighting& Sighting) const;
+
+protected:
+
+	/** Returns true if a sighting is still valid */
+	bool IsSightingValid(const FShooterSquadSighting& Sighting, double Now) const;
+};
@@ -4,14 +4,21 @@
 #include "Variant_Shooter/AI/ShooterStateTreeUtility.h"
 #include "StateTreeExecutionContext.h"
 #include "ShooterNPC.h"
-#include "Camera/CameraComponent.h"
 #include "AIController.h"
 #include "Perception/AIPerceptionComponent.h"
 #include "ShooterAIController.h"
 #include "StateTreeAsyncExecutionContext.h"
+#include "ShooterEQSBudgetSubsystem.h"
+#include "ShooterSquadKnowledgeSubsystem.h"
+#include "ShooterPathBrokerSubsystem.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "EnvironmentQuery/EnvQuery.h"
+#include "ProjectXSStats.h"
 
 bool FStateTreeLineOfSightToTargetCondition::TestCondition(FStateTreeExecutionContext& Context) const
 {
+	XS_SCOPE_CYCLE_COUNTER(STAT_XS_LineOfSightCondition);
+
 	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
 	// ensure the target is valid
@@ -20,14 +27,8 @@ bool FStateTreeLineOfSightToTargetCondition::TestCondition(FStateTreeExecutionCo
 		return !InstanceData.bMustHaveLineOfSight;
 	}
 	
-	// check if the character is facing towards the target
-	const FVector TargetDir = (InstanceData.Target->GetActorLocation() - InstanceData.Character->GetActorLocation()).GetSafeNormal();
-
-	const float FacingDot = FVector::DotProduct(TargetDir, InstanceData.Character->GetActorForwardVector());
-	const float MaxDot = FMath::Cos(FMath::DegreesToRadians(InstanceData.LineOfSightConeAngle));
-
 	// is the facing outside of our cone half angle?
-	if (FacingDot <= MaxDot)
+	if (!IsInFacingCone(InstanceData.Character->GetActorLocation(), InstanceData.Character->GetActorForwardVector(), InstanceData.Target->GetActorLocation(), InstanceData.LineOfSightConeAngle))
 	{
 		return !InstanceData.bMustHaveLineOfSight;
 	}
@@ -39,8 +40,9 @@ bool FStateTreeLineOfSightToTargetCondition::TestCondition(FStateTreeExecutionCo
 	// divide the vertical extent by the number of line of sight checks we'll do
 	const float ExtentZOffset = Extent.Z * 2.0f / InstanceData.NumberOfVerticalLineOfSightChecks;
 
-	// get the character's camera location as the source for the line checks
-	const FVector Start = InstanceData.Character->GetFirstPersonCameraComponent()->GetComponentLocation();
+	// get the character's aim source as the source for the line checks
+	FVector Start, AimForward;
+	InstanceData.Character->GetAimSource(Start, AimForward);
 
 	// ignore the character and target. We want to ensure there's an unobstructed trace not counting them
 	FCollisionQueryParams QueryParams;
@@ -55,6 +57,7 @@ bool FStateTreeLineOfSightToTargetCondition::TestCondition(FStateTreeExecutionCo
 		// calculate the endpoint for the trace
 		const FVector End = CenterOfMass + FVector(0.0f, 0.0f, Extent.Z - ExtentZOffset * i);
 
+		XS_INC_TRACES(1);
 		InstanceData.Character->GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECC_Visibility, QueryParams);
 
 		// is the trace unobstructed?
@@ -69,6 +72,17 @@ bool FStateTreeLineOfSightToTargetCondition::TestCondition(FStateTreeExecutionCo
 	return !InstanceData.bMustHaveLineOfSight;
 }
 
+bool FStateTreeLineOfSightToTargetCondition::IsInFacingCone(const FVector& Location, const FVector& Forward, const FVector& TargetLocation, float ConeHalfAngle)
+{
+	// check if the character is facing towards the target
+	const FVector TargetDir = (TargetLocation - Location).GetSafeNormal();
+
+	const float FacingDot = FVector::DotProduct(TargetDir, Forward);
+	const float MaxDot = FMath::Cos(FMath::DegreesToRadians(ConeHalfAngle));
+
+	return FacingDot > MaxDot;
+}
+
 #if WITH_EDITOR
 FText FStateTreeLineOfSightToTargetCondition::GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting /*= EStateTreeNodeFormatting::Text*/) const
 {
@@ -219,124 +233,132 @@ EStateTreeRunStatus FStateTreeSenseEnemiesTask::EnterState(FStateTreeExecutionCo
 		// get the instance data
 		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
-		// bind the perception updated delegate on the controller
-		InstanceData.Controller->OnShooterPerceptionUpdated.BindLambda(
-			[WeakContext = Context.MakeWeakExecutionContext()](AActor* SensedActor, const FAIStimulus& Stimulus)
+		// have the controller trace line of sight for the actors and cone we sense
+		InstanceData.LineOfSightFilter = { InstanceData.SenseTag, InstanceData.DirectLineOfSightCone };
+		InstanceData.Controller->AddLineOfSightFilter(InstanceData.LineOfSightFilter);
+
+		// listen for the controller's perception batches
+		InstanceData.PerceptionEventsHandle = InstanceData.Controller->OnShooterPerceptionEvents.AddLambda(
+			[WeakContext = Context.MakeWeakExecutionContext()](const TArray<FShooterPerceptionEvent>& Events)
 			{
 				// get the instance data inside the lambda
 				const FStateTreeStrongExecutionContext StrongContext = WeakContext.MakeStrongExecutionContext();
 				if (FInstanceDataType* LambdaInstanceData = StrongContext.GetInstanceDataPtr<FInstanceDataType>())
 				{
-					if (SensedActor->ActorHasTag(LambdaInstanceData->SenseTag))
+					for (const FShooterPerceptionEvent& Event : Events)
 					{
-						bool bDirectLOS = false;
-
-						// calculate the direction of the stimulus
-						const FVector StimulusDir = (Stimulus.StimulusLocation - LambdaInstanceData->Character->GetActorLocation()).GetSafeNormal();
-
-						// infer the angle from the dot product between the character facing and the stimulus direction
-						const float DirDot = FVector::DotProduct(StimulusDir, LambdaInstanceData->Character->GetActorForwardVector());
-						const float MaxDot = FMath::Cos(FMath::DegreesToRadians(LambdaInstanceData->DirectLineOfSightCone));
+						AActor* SensedActor = Event.Actor.Get();
 
-						// is the direction within our perception cone?
-						if (DirDot >= MaxDot)
+						if (!SensedActor)
 						{
-							// run a line trace between the character and the sensed actor
-							FCollisionQueryParams QueryParams;
-							QueryParams.AddIgnoredActor(LambdaInstanceData->Character);
-							QueryParams.AddIgnoredActor(SensedActor);
-
-							FHitResult OutHit;
-
-							// we have direct line of sight if this trace is unobstructed
-							bDirectLOS = !LambdaInstanceData->Character->GetWorld()->LineTraceSingleByChannel(OutHit, LambdaInstanceData->Character->GetActorLocation(), SensedActor->GetActorLocation(), ECC_Visibility, QueryParams);
-
+							continue;
 						}
 
-						// check if we have a direct line of sight to the stimulus
-						if (bDirectLOS)
+						if (Event.bForgotten)
 						{
-							// set the controller's target
-							LambdaInstanceData->Controller->SetCurrentTarget(SensedActor);
+							ForgetSensedActor(*LambdaInstanceData, SensedActor);
 
-							// set the task output
-							LambdaInstanceData->TargetActor = SensedActor;
-
-							// set the flags
-							LambdaInstanceData->bHasTarget = true;
-							LambdaInstanceData->bHasInvestigateLocation = false;
-
-						// no direct line of sight to target
 						} else {
 
-							// if we already have a target, ignore the partial sense and keep on them
-							if (!IsValid(LambdaInstanceData->TargetActor))
-							{
-								// is this stimulus stronger than the last one we had?
-								if (Stimulus.Strength > LambdaInstanceData->LastStimulusStrength)
-								{
-									// update the stimulus strength
-									LambdaInstanceData->LastStimulusStrength = Stimulus.Strength;
-
-									// set the investigate location
-									LambdaInstanceData->InvestigateLocation = Stimulus.StimulusLocation;
-
-									// set the investigate flag
-									LambdaInstanceData->bHasInvestigateLocation = true;
-								}
-							}
+							SenseActor(*LambdaInstanceData, SensedActor, Event.Stimulus, Event.bHasLineOfSight);
 						}
 					}
 				}
 			}
 		);
+	}
 
-		// bind the perception forgotten delegate on the controller
-		InstanceData.Controller->OnShooterPerceptionForgotten.BindLambda(
-			[WeakContext = Context.MakeWeakExecutionContext()](AActor* SensedActor)
-			{
-				// get the instance data inside the lambda
-				const FStateTreeStrongExecutionContext StrongContext = WeakContext.MakeStrongExecutionContext();
-				if (FInstanceDataType* LambdaInstanceData = StrongContext.GetInstanceDataPtr<FInstanceDataType>())
-				{
-					bool bForget = false;
+	return EStateTreeRunStatus::Running;
+}
 
-					// are we forgetting the current target?
-					if (SensedActor == LambdaInstanceData->TargetActor)
-					{
-						bForget = true;
-					}
-					else 
-					{
-						// are we forgetting about a partial sense?
-						if (!IsValid(LambdaInstanceData->TargetActor))
-						{
-							bForget = true;
-						}
-					}
+void FStateTreeSenseEnemiesTask::SenseActor(FInstanceDataType& InstanceData, AActor* SensedActor, const FAIStimulus& Stimulus, bool bHasLineOfSight)
+{
+	XS_SCOPE_CYCLE_COUNTER(STAT_XS_SenseEnemies);
 
-					if (bForget)
-					{
-						// clear the target
-						LambdaInstanceData->TargetActor = nullptr;
+	if (!SensedActor->ActorHasTag(InstanceData.SenseTag))
+	{
+		return;
+	}
 
-						// clear the flags
-						LambdaInstanceData->bHasInvestigateLocation = false;
-						LambdaInstanceData->bHasTarget = false;
+	// calculate the direction of the stimulus
+	const FVector StimulusDir = (Stimulus.StimulusLocation - InstanceData.Character->GetActorLocation()).GetSafeNormal();
 
-						// reset the stimulus strength
-						LambdaInstanceData->LastStimulusStrength = 0.0f;
+	// infer the angle from the dot product between the character facing and the stimulus direction
+	const float DirDot = FVector::DotProduct(StimulusDir, InstanceData.Character->GetActorForwardVector());
+	const float MaxDot = FMath::Cos(FMath::DegreesToRadians(InstanceData.DirectLineOfSightCone));
 
-						// clear the target on the controller
-						LambdaInstanceData->Controller->ClearCurrentTarget();
-						LambdaInstanceData->Controller->ClearFocus(EAIFocusPriority::Gameplay);
-					}
-				}
+	// the controller already traced line of sight for this batch, we only need the stimulus within our perception cone
+	const bool bDirectLOS = bHasLineOfSight && DirDot >= MaxDot;
+
+	// check if we have a direct line of sight to the stimulus
+	if (bDirectLOS)
+	{
+		// set the controller's target
+		InstanceData.Controller->SetCurrentTarget(SensedActor);
+
+		// set the task output
+		InstanceData.TargetActor = SensedActor;
+
+		// set the flags
+		InstanceData.bHasTarget = true;
+		InstanceData.bHasInvestigateLocation = false;
+
+	// no direct line of sight to target
+	} else {
+
+		// if we already have a target, ignore the partial sense and keep on them
+		if (!IsValid(InstanceData.TargetActor))
+		{
+			// is this stimulus stronger than the last one we had?
+			if (Stimulus.Strength > InstanceData.LastStimulusStrength)
+			{
+				// update the stimulus strength
+				InstanceData.LastStimulusStrength = Stimulus.Strength;
+
+				// set the investigate location
+				InstanceData.InvestigateLocation = Stimulus.StimulusLocation;
+
+				// set the investigate flag
+				InstanceData.bHasInvestigateLocation = true;
 			}
-		);
+		}
 	}
+}
 
-	return EStateTreeRunStatus::Running;
+void FStateTreeSenseEnemiesTask::ForgetSensedActor(FInstanceDataType& InstanceData, AActor* SensedActor)
+{
+	bool bForget = false;
+
+	// are we forgetting the current target?
+	if (SensedActor == InstanceData.TargetActor)
+	{
+		bForget = true;
+	}
+	else 
+	{
+		// are we forgetting about a partial sense?
+		if (!IsValid(InstanceData.TargetActor))
+		{
+			bForget = true;
+		}
+	}
+
+	if (bForget)
+	{
+		// clear the target
+		InstanceData.TargetActor = nullptr;
+
+		// clear the flags
+		InstanceData.bHasInvestigateLocation = false;
+		InstanceData.bHasTarget = false;
+
+		// reset the stimulus strength
+		InstanceData.LastStimulusStrength = 0.0f;
+
+		// clear the target on the controller
+		InstanceData.Controller->ClearCurrentTarget();
+		InstanceData.Controller->ClearFocus(EAIFocusPriority::Gameplay);
+	}
 }
 
 void FStateTreeSenseEnemiesTask::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
@@ -347,9 +369,11 @@ void FStateTreeSenseEnemiesTask::ExitState(FStateTreeExecutionContext& Context,
 		// get the instance data
 		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
-		// unbind the perception delegates
-		InstanceData.Controller->OnShooterPerceptionUpdated.Unbind();
-		InstanceData.Controller->OnShooterPerceptionForgotten.Unbind();
+		// stop listening for perception batches
+		InstanceData.Controller->OnShooterPerceptionEvents.Remove(InstanceData.PerceptionEventsHandle);
+		InstanceData.PerceptionEventsHandle.Reset();
+
+		InstanceData.Controller->RemoveLineOfSightFilter(InstanceData.LineOfSightFilter);
 	}
 }
 
@@ -358,4 +382,245 @@ FText FStateTreeSenseEnemiesTask::GetDescription(const FGuid& ID, FStateTreeData
 {
 	return FText::FromString("<b>Sense Enemies</b>");
 }
-#endif // WITH_EDITOR
\ No newline at end of file
+#endif // WITH_EDITOR
+
+EStateTreeRunStatus FStateTreeRunBudgetedEnvQueryTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	// get the instance data
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	UShooterEQSBudgetSubsystem* EQSBudget = Context.GetWorld()->GetSubsystem<UShooterEQSBudgetSubsystem>();
+
+	if (!EQSBudget || !InstanceData.QueryTemplate || !IsValid(InstanceData.Controller))
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	// queue the query and finish the task once we get the result
+	InstanceData.RequestId = EQSBudget->RequestQuery(InstanceData.QueryTemplate, InstanceData.Controller, InstanceData.RunMode,
+		FQueryFinishedSignature::CreateLambda([WeakContext = Context.MakeWeakExecutionContext()](TSharedPtr<FEnvQueryResult> Result)
+		{
+			// get the instance data inside the lambda
+			const FStateTreeStrongExecutionContext StrongContext = WeakContext.MakeStrongExecutionContext();
+			if (FInstanceDataType* LambdaInstanceData = StrongContext.GetInstanceDataPtr<FInstanceDataType>())
+			{
+				LambdaInstanceData->RequestId = INDEX_NONE;
+
+				// a null result means the query was dropped by the budget
+				const bool bSuccess = Result.IsValid() && Result->IsSuccessful() && Result->Items.Num() > 0;
+
+				if (bSuccess)
+				{
+					LambdaInstanceData->ResultLocation = Result->GetItemAsLocation(0);
+					LambdaInstanceData->ResultActor = Result->GetItemAsActor(0);
+				}
+
+				StrongContext.FinishTask(bSuccess ? EStateTreeFinishTaskType::Succeeded : EStateTreeFinishTaskType::Failed);
+			}
+		}));
+
+	return InstanceData.RequestId != INDEX_NONE ? EStateTreeRunStatus::Running : EStateTreeRunStatus::Failed;
+}
+
+void FStateTreeRunBudgetedEnvQueryTask::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	// get the instance data
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	// abort the query if it's still queued or running
+	if (InstanceData.RequestId != INDEX_NONE)
+	{
+		if (UShooterEQSBudgetSubsystem* EQSBudget = Context.GetWorld()->GetSubsystem<UShooterEQSBudgetSubsystem>())
+		{
+			EQSBudget->AbortQuery(InstanceData.RequestId);
+		}
+
+		InstanceData.RequestId = INDEX_NONE;
+	}
+}
+
+#if WITH_EDITOR
+FText FStateTreeRunBudgetedEnvQueryTask::GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting /*= EStateTreeNodeFormatting::Text*/) const
+{
+	return FText::FromString("<b>Run Budgeted Env Query</b>");
+}
+#endif // WITH_EDITOR
+
+EStateTreeRunStatus FStateTreeSquadKnowledgeTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	// read the shared knowledge right away so the outputs are valid on the first frame
+	UpdateSharedKnowledge(Context);
+
+	return EStateTreeRunStatus::Running;
+}
+
+EStateTreeRunStatus FStateTreeSquadKnowledgeTask::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	UpdateSharedKnowledge(Context);
+
+	return EStateTreeRunStatus::Running;
+}
+
+void FStateTreeSquadKnowledgeTask::UpdateSharedKnowledge(FStateTreeExecutionContext& Context) const
+{
+	// get the instance data
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	InstanceData.bHasSharedTarget = false;
+
+	UShooterSquadKnowledgeSubsystem* SquadKnowledge = Context.GetWorld()->GetSubsystem<UShooterSquadKnowledgeSubsystem>();
+
+	if (!SquadKnowledge || !IsValid(InstanceData.Character))
+	{
+		return;
+	}
+
+	// look up the freshest sighting shared by a nearby teammate
+	FShooterSquadSighting Sighting;
+
+	if (SquadKnowledge->GetSharedSighting(InstanceData.Character->GetTeamByte(), InstanceData.Character->GetActorLocation(), Sighting))
+	{
+		InstanceData.Confidence = SquadKnowledge->GetSightingConfidence(Sighting);
+
+		// ignore sightings we no longer trust
+		if (InstanceData.Confidence >= InstanceData.MinConfidence)
+		{
+			InstanceData.SharedTarget = Sighting.Target.Get();
+			InstanceData.SharedTargetLocation = Sighting.TargetLocation;
+			InstanceData.bHasSharedTarget = true;
+		}
+	}
+}
+
+#if WITH_EDITOR
+FText FStateTreeSquadKnowledgeTask::GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting /*= EStateTreeNodeFormatting::Text*/) const
+{
+	return FText::FromString("<b>Get Squad Knowledge</b>");
+}
+#endif // WITH_EDITOR
+
+EStateTreeRunStatus FStateTreeBudgetedMoveToTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	// get the instance data
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	InstanceData.MoveRequestId = FAIRequestID::InvalidRequest;
+	InstanceData.MoveStatus = EStateTreeRunStatus::Running;
+
+	UShooterPathBrokerSubsystem* PathBroker = Context.GetWorld()->GetSubsystem<UShooterPathBrokerSubsystem>();
+
+	if (!PathBroker || !IsValid(InstanceData.Controller))
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	// queue the path request and start moving once the broker finds it
+	InstanceData.PathRequestId = PathBroker->RequestPath(InstanceData.Controller, InstanceData.Destination, InstanceData.AcceptanceRadius,
+		FShooterPathReadyDelegate::CreateLambda([WeakContext = Context.MakeWeakExecutionContext()](FNavPathSharedPtr Path)
+		{
+			// get the instance data inside the lambda
+			const FStateTreeStrongExecutionContext StrongContext = WeakContext.MakeStrongExecutionContext();
+			if (FInstanceDataType* LambdaInstanceData = StrongContext.GetInstanceDataPtr<FInstanceDataType>())
+			{
+				LambdaInstanceData->PathRequestId = INDEX_NONE;
+
+				UPathFollowingComponent* PathFollowing = IsValid(LambdaInstanceData->Controller) ? LambdaInstanceData->Controller->GetPathFollowingComponent() : nullptr;
+
+				if (Path.IsValid() && PathFollowing)
+				{
+					FAIMoveRequest MoveRequest(LambdaInstanceData->Destination);
+					MoveRequest.SetAcceptanceRadius(LambdaInstanceData->AcceptanceRadius);
+
+					LambdaInstanceData->MoveRequestId = LambdaInstanceData->Controller->RequestMove(MoveRequest, Path);
+
+					if (LambdaInstanceData->MoveRequestId.IsValid())
+					{
+						if (PathFollowing->GetStatus() == EPathFollowingStatus::Idle)
+						{
+							// already at the goal, the move finished inside RequestMove
+							LambdaInstanceData->MoveStatus = PathFollowing->DidMoveReachGoal() ? EStateTreeRunStatus::Succeeded : EStateTreeRunStatus::Failed;
+
+						} else {
+
+							// path following resets its request id when a move ends, so keep the result of our own request
+							LambdaInstanceData->MoveFinishedHandle = PathFollowing->OnRequestFinished.AddLambda([WeakContext](FAIRequestID RequestID, const FPathFollowingResult& Result)
+							{
+								const FStateTreeStrongExecutionContext FinishedContext = WeakContext.MakeStrongExecutionContext();
+								if (FInstanceDataType* FinishedInstanceData = FinishedContext.GetInstanceDataPtr<FInstanceDataType>())
+								{
+									if (RequestID == FinishedInstanceData->MoveRequestId)
+									{
+										FinishedInstanceData->MoveStatus = Result.IsSuccess() ? EStateTreeRunStatus::Succeeded : EStateTreeRunStatus::Failed;
+									}
+								}
+							});
+						}
+					}
+				}
+
+				// no path, or path following refused it
+				if (!LambdaInstanceData->MoveRequestId.IsValid())
+				{
+					StrongContext.FinishTask(EStateTreeFinishTaskType::Failed);
+				}
+			}
+		}));
+
+	return InstanceData.PathRequestId != INDEX_NONE ? EStateTreeRunStatus::Running : EStateTreeRunStatus::Failed;
+}
+
+EStateTreeRunStatus FStateTreeBudgetedMoveToTask::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	// get the instance data
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	// still waiting on the path
+	if (!InstanceData.MoveRequestId.IsValid())
+	{
+		return EStateTreeRunStatus::Running;
+	}
+
+	// reached the goal, or failed, aborted or replaced by another move
+	return InstanceData.MoveStatus;
+}
+
+void FStateTreeBudgetedMoveToTask::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	// get the instance data
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	// stop waiting for the path
+	if (InstanceData.PathRequestId != INDEX_NONE)
+	{
+		if (UShooterPathBrokerSubsystem* PathBroker = Context.GetWorld()->GetSubsystem<UShooterPathBrokerSubsystem>())
+		{
+			PathBroker->CancelRequest(InstanceData.PathRequestId);
+		}
+
+		InstanceData.PathRequestId = INDEX_NONE;
+	}
+
+	// stop our move if it's still running
+	if (InstanceData.MoveRequestId.IsValid() && IsValid(InstanceData.Controller))
+	{
+		if (UPathFollowingComponent* PathFollowing = InstanceData.Controller->GetPathFollowingComponent())
+		{
+			PathFollowing->OnRequestFinished.Remove(InstanceData.MoveFinishedHandle);
+
+			if (PathFollowing->GetCurrentRequestId() == InstanceData.MoveRequestId && PathFollowing->GetStatus() != EPathFollowingStatus::Idle)
+			{
+				PathFollowing->AbortMove(*InstanceData.Controller, FPathFollowingResultFlags::OwnerFinished, InstanceData.MoveRequestId);
+			}
+		}
+	}
+
+	InstanceData.MoveRequestId = FAIRequestID::InvalidRequest;
+	InstanceData.MoveFinishedHandle.Reset();
+}
+
+#if WITH_EDITOR
+FText FStateTreeBudgetedMoveToTask::GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting /*= EStateTreeNodeFormatting::Text*/) const
+{
+	return FText::FromString("<b>Budgeted Move To</b>");
+}
+#endif // WITH_EDITOR
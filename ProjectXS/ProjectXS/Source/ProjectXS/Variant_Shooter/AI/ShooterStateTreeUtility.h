@@ -5,12 +5,17 @@
 #include "CoreMinimal.h"
 #include "StateTreeTaskBase.h"
 #include "StateTreeConditionBase.h"
+#include "EnvironmentQuery/EnvQueryTypes.h"
+#include "AITypes.h"
+#include "ShooterAIController.h"
 
 #include "ShooterStateTreeUtility.generated.h"
 
 class AShooterNPC;
 class AAIController;
 class AShooterAIController;
+class UEnvQuery;
+struct FAIStimulus;
 
 /**
  *  Instance data struct for the FStateTreeLineOfSightToTargetCondition condition
@@ -60,6 +65,9 @@ struct FStateTreeLineOfSightToTargetCondition : public FStateTreeConditionCommon
 	/** Tests the StateTree condition */
 	virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
 
+	/** Returns true if the target location is inside the facing cone half angle, in degrees */
+	static bool IsInFacingCone(const FVector& Location, const FVector& Forward, const FVector& TargetLocation, float ConeHalfAngle);
+
 #if WITH_EDITOR
 	/** Provides the description string */
 	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
@@ -281,6 +289,12 @@ struct FStateTreeSenseEnemiesInstanceData
 	/** Strength of the last processed stimulus */
 	UPROPERTY(EditAnywhere)
 	float LastStimulusStrength = 0.0f;
+
+	/** Handle for the controller's perception batch delegate */
+	FDelegateHandle PerceptionEventsHandle;
+
+	/** Line of sight filter registered with the controller while the task runs */
+	FShooterLineOfSightFilter LineOfSightFilter;
 };
 
 /**
@@ -301,9 +315,202 @@ struct FStateTreeSenseEnemiesTask : public FStateTreeTaskCommonBase
 	/** Runs when the owning state is ended */
 	virtual void ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
 
+#if WITH_EDITOR
+	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
+#endif // WITH_EDITOR
+
+protected:
+
+	/** Processes a perceived actor from a perception batch */
+	static void SenseActor(FInstanceDataType& InstanceData, AActor* SensedActor, const FAIStimulus& Stimulus, bool bHasLineOfSight);
+
+	/** Processes a forgotten actor from a perception batch */
+	static void ForgetSensedActor(FInstanceDataType& InstanceData, AActor* SensedActor);
+};
+
+////////////////////////////////////////////////////////////////////
+
+/**
+ *  Instance data struct for the Run Budgeted Env Query StateTree task
+ */
+USTRUCT()
+struct FStateTreeRunBudgetedEnvQueryInstanceData
+{
+	GENERATED_BODY()
+
+	/** AI Controller running the query */
+	UPROPERTY(EditAnywhere, Category = Context)
+	TObjectPtr<AShooterAIController> Controller;
+
+	/** Query to run */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	TObjectPtr<UEnvQuery> QueryTemplate;
+
+	/** Determines which items the query returns */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	TEnumAsByte<EEnvQueryRunMode::Type> RunMode = EEnvQueryRunMode::SingleResult;
+
+	/** Location of the best item */
+	UPROPERTY(EditAnywhere, Category = Output)
+	FVector ResultLocation = FVector::ZeroVector;
+
+	/** Actor of the best item, if the query returns actors */
+	UPROPERTY(EditAnywhere, Category = Output)
+	TObjectPtr<AActor> ResultActor;
+
+	/** Budgeted request id */
+	UPROPERTY()
+	int32 RequestId = INDEX_NONE;
+};
+
+/**
+ *  StateTree task to run an EQS query through the shooter EQS budget
+ *  Succeeds when the query returns an item, fails if it returns nothing or is dropped
+ */
+USTRUCT(meta=(DisplayName="Run Budgeted Env Query", Category="Shooter"))
+struct FStateTreeRunBudgetedEnvQueryTask : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	/* Ensure we're using the correct instance data struct */
+	using FInstanceDataType = FStateTreeRunBudgetedEnvQueryInstanceData;
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	/** Runs when the owning state is entered */
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
+	/** Runs when the owning state is ended */
+	virtual void ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
 #if WITH_EDITOR
 	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
 #endif // WITH_EDITOR
 };
 
-////////////////////////////////////////////////////////////////////
\ No newline at end of file
+////////////////////////////////////////////////////////////////////
+
+/**
+ *  Instance data struct for the Get Squad Knowledge StateTree task
+ */
+USTRUCT()
+struct FStateTreeSquadKnowledgeInstanceData
+{
+	GENERATED_BODY()
+
+	/** NPC reading its squad's knowledge */
+	UPROPERTY(EditAnywhere, Category = Context)
+	TObjectPtr<AShooterNPC> Character;
+
+	/** Min confidence for a shared sighting to be used */
+	UPROPERTY(EditAnywhere, Category = Parameter, meta = (ClampMin = 0, ClampMax = 1))
+	float MinConfidence = 0.2f;
+
+	/** Target sighted by a nearby teammate */
+	UPROPERTY(EditAnywhere, Category = Output)
+	TObjectPtr<AActor> SharedTarget;
+
+	/** Where the teammate last saw the target */
+	UPROPERTY(EditAnywhere, Category = Output)
+	FVector SharedTargetLocation = FVector::ZeroVector;
+
+	/** How much the shared sighting can still be trusted, decays from 1 to 0 */
+	UPROPERTY(EditAnywhere, Category = Output)
+	float Confidence = 0.0f;
+
+	/** True if a nearby teammate shared a trusted sighting */
+	UPROPERTY(EditAnywhere, Category = Output)
+	bool bHasSharedTarget = false;
+};
+
+/**
+ *  StateTree task to read the freshest target sighting shared by nearby teammates
+ */
+USTRUCT(meta=(DisplayName="Get Squad Knowledge", Category="Shooter"))
+struct FStateTreeSquadKnowledgeTask : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	/* Ensure we're using the correct instance data struct */
+	using FInstanceDataType = FStateTreeSquadKnowledgeInstanceData;
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	/** Runs when the owning state is entered */
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
+	/** Runs while the owning state is active */
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+
+#if WITH_EDITOR
+	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
+#endif // WITH_EDITOR
+
+protected:
+
+	/** Refreshes the task outputs from the squad knowledge */
+	void UpdateSharedKnowledge(FStateTreeExecutionContext& Context) const;
+};
+
+////////////////////////////////////////////////////////////////////
+
+/**
+ *  Instance data struct for the Budgeted Move To StateTree task
+ */
+USTRUCT()
+struct FStateTreeBudgetedMoveToInstanceData
+{
+	GENERATED_BODY()
+
+	/** AI Controller that will move */
+	UPROPERTY(EditAnywhere, Category = Context)
+	TObjectPtr<AShooterAIController> Controller;
+
+	/** Location to move to */
+	UPROPERTY(EditAnywhere, Category = Input)
+	FVector Destination = FVector::ZeroVector;
+
+	/** Distance from the destination at which the move succeeds */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	float AcceptanceRadius = 50.0f;
+
+	/** Path broker request id */
+	UPROPERTY()
+	int32 PathRequestId = INDEX_NONE;
+
+	/** Path following request, once the path is found */
+	FAIRequestID MoveRequestId;
+
+	/** Result of our path following request. Running until it finishes */
+	EStateTreeRunStatus MoveStatus = EStateTreeRunStatus::Running;
+
+	/** Handle for the path following request finished delegate */
+	FDelegateHandle MoveFinishedHandle;
+};
+
+/**
+ *  StateTree task to move an NPC using a path from the shooter path broker
+ *  Succeeds when the destination is reached, fails if no path is found or the move is aborted
+ */
+USTRUCT(meta=(DisplayName="Budgeted Move To", Category="Shooter"))
+struct FStateTreeBudgetedMoveToTask : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	/* Ensure we're using the correct instance data struct */
+	using FInstanceDataType = FStateTreeBudgetedMoveToInstanceData;
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	/** Runs when the owning state is entered */
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
+	/** Runs while the owning state is active */
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+
+	/** Runs when the owning state is ended */
+	virtual void ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
+#if WITH_EDITOR
+	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
+#endif // WITH_EDITOR
+};
+
+////////////////////////////////////////////////////////////////////
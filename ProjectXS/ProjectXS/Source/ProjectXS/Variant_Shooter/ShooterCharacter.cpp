@@ -8,10 +8,12 @@
 #include "Components/PawnNoiseEmitterComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Components/CapsuleComponent.h"
 #include "Engine/World.h"
 #include "Camera/CameraComponent.h"
 #include "TimerManager.h"
 #include "ShooterGameMode.h"
+#include "ShooterPlayerController.h"
 
 AShooterCharacter::AShooterCharacter()
 {
@@ -29,6 +31,10 @@ void AShooterCharacter::BeginPlay()
 	// reset HP to max
 	CurrentHP = MaxHP;
 
+	// save the initial collision so it can be restored if this character is reused on respawn
+	DefaultMeshCollisionProfile = GetMesh()->GetCollisionProfileName();
+	DefaultCapsuleCollision = GetCapsuleComponent()->GetCollisionEnabled();
+
 	// update the HUD
 	OnDamaged.Broadcast(1.0f);
 }
@@ -173,10 +179,18 @@ void AShooterCharacter::AttachWeaponMeshes(AShooterWeapon* Weapon)
 	// attach the weapon actor
 	Weapon->AttachToActor(this, AttachmentRule);
 
-	// attach the weapon meshes
-	Weapon->GetFirstPersonMesh()->AttachToComponent(GetFirstPersonMesh(), AttachmentRule, FirstPersonWeaponSocket);
+	// attach the weapon meshes. Dedicated servers have no use for the first person mesh
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		Weapon->DisableFirstPersonMesh();
+
+	} else {
+
+		Weapon->GetFirstPersonMesh()->AttachToComponent(GetFirstPersonMesh(), AttachmentRule, FirstPersonWeaponSocket);
+
+	}
+
 	Weapon->GetThirdPersonMesh()->AttachToComponent(GetMesh(), AttachmentRule, FirstPersonWeaponSocket);
-	
 }
 
 void AShooterCharacter::PlayFiringMontage(UAnimMontage* Montage)
@@ -251,14 +265,48 @@ void AShooterCharacter::OnWeaponActivated(AShooterWeapon* Weapon)
 	// update the bullet counter
 	OnBulletCountUpdated.Broadcast(Weapon->GetMagazineSize(), Weapon->GetBulletCount());
 
-	// set the character mesh AnimInstances
-	GetFirstPersonMesh()->SetAnimInstanceClass(Weapon->GetFirstPersonAnimInstanceClass());
-	GetMesh()->SetAnimInstanceClass(Weapon->GetThirdPersonAnimInstanceClass());
+	// set the character mesh animation. The first person graph never runs on a dedicated server
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		ApplyWeaponAnimation(GetFirstPersonMesh(), Weapon->GetFirstPersonAnimInstanceClass(), Weapon->GetFirstPersonAnimLayerClass());
+	}
+
+	ApplyWeaponAnimation(GetMesh(), Weapon->GetThirdPersonAnimInstanceClass(), Weapon->GetThirdPersonAnimLayerClass());
 }
 
 void AShooterCharacter::OnWeaponDeactivated(AShooterWeapon* Weapon)
 {
-	// unused
+	// unlink the weapon's anim layers
+	if (Weapon->GetFirstPersonAnimLayerClass() && GetFirstPersonMesh())
+	{
+		GetFirstPersonMesh()->UnlinkAnimClassLayers(Weapon->GetFirstPersonAnimLayerClass());
+	}
+
+	if (Weapon->GetThirdPersonAnimLayerClass())
+	{
+		GetMesh()->UnlinkAnimClassLayers(Weapon->GetThirdPersonAnimLayerClass());
+	}
+}
+
+void AShooterCharacter::ApplyWeaponAnimation(USkeletalMeshComponent* CharacterMesh, const TSubclassOf<UAnimInstance>& AnimInstanceClass, const TSubclassOf<UAnimInstance>& AnimLayerClass)
+{
+	if (!CharacterMesh)
+	{
+		return;
+	}
+
+	// link the layers into the running graph
+	if (AnimLayerClass)
+	{
+		CharacterMesh->LinkAnimClassLayers(AnimLayerClass);
+		return;
+	}
+
+	// only swap the AnimInstance if it's actually different, since this reinitializes the graph
+	if (CharacterMesh->GetAnimClass() != AnimInstanceClass)
+	{
+		CharacterMesh->SetAnimInstanceClass(AnimInstanceClass);
+	}
 }
 
 void AShooterCharacter::OnSemiWeaponRefire()
@@ -317,10 +365,91 @@ void AShooterCharacter::Die()
 
 void AShooterCharacter::OnRespawn()
 {
+	// try to reuse this character
+	if (AShooterPlayerController* PC = Cast<AShooterPlayerController>(GetController()))
+	{
+		if (PC->RespawnPawnInPlace(this))
+		{
+			return;
+		}
+	}
+
 	// destroy the character to force the PC to respawn
 	Destroy();
 }
 
+bool AShooterCharacter::ResetForRespawn(const FTransform& SpawnTransform)
+{
+	// move to the spawn point. If we can't, stay dead and let the controller respawn a new character
+	if (!TeleportTo(SpawnTransform.GetLocation(), SpawnTransform.Rotator(), false, true))
+	{
+		return false;
+	}
+
+	// clear the respawn timer
+	GetWorld()->GetTimerManager().ClearTimer(RespawnTimer);
+
+	// reset HP to max
+	CurrentHP = MaxHP;
+
+	// remove the death tag
+	Tags.Remove(DeathTag);
+
+	// undo the ragdoll and death camera
+	ClearDeathState();
+
+	// reset character movement
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+
+	// re-enable controls
+	EnableInput(nullptr);
+
+	// drop every weapon, a freshly spawned character starts unarmed until it finds a pickup
+	for (AShooterWeapon* Weapon : OwnedWeapons)
+	{
+		if (IsValid(Weapon))
+		{
+			Weapon->Destroy();
+		}
+	}
+
+	OwnedWeapons.Reset();
+	CurrentWeapon = nullptr;
+
+	// update the HUD
+	OnDamaged.Broadcast(1.0f);
+	OnBulletCountUpdated.Broadcast(0, 0);
+
+	// call the BP handler
+	BP_OnRespawned();
+
+	return true;
+}
+
+void AShooterCharacter::ClearDeathState()
+{
+	// stop the ragdoll
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->SetPhysicsBlendWeight(0.0f);
+	GetMesh()->SetCollisionProfileName(DefaultMeshCollisionProfile);
+
+	// put the mesh back on the capsule
+	GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	GetMesh()->SetRelativeLocationAndRotation(GetBaseTranslationOffset(), GetBaseRotationOffset());
+
+	// restore capsule collision
+	GetCapsuleComponent()->SetCollisionEnabled(DefaultCapsuleCollision);
+
+	// switch back from the death camera to the first person camera
+	GetFirstPersonCameraComponent()->SetActive(true);
+
+	if (APlayerController* PC = Cast<APlayerController>(GetController()))
+	{
+		PC->SetViewTarget(this);
+	}
+}
+
 bool AShooterCharacter::IsDead() const
 {
 	// the character is dead if their current HP drops to zero
@@ -11,6 +11,7 @@ class AShooterWeapon;
 class UInputAction;
 class UInputComponent;
 class UPawnNoiseEmitterComponent;
+class UAnimInstance;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FBulletCountUpdatedDelegate, int32, MagazineSize, int32, Bullets);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDamagedDelegate, float, LifePercent);
@@ -77,6 +78,12 @@ protected:
 
 	FTimerHandle RespawnTimer;
 
+	/** Mesh collision profile to restore after the death ragdoll */
+	FName DefaultMeshCollisionProfile;
+
+	/** Capsule collision mode to restore after death */
+	ECollisionEnabled::Type DefaultCapsuleCollision = ECollisionEnabled::QueryAndPhysics;
+
 public:
 
 	/** Bullet count updated delegate */
@@ -167,6 +174,9 @@ public:
 
 protected:
 
+	/** Applies a weapon's animation to a character mesh, linking anim layers when available to avoid reinitializing the AnimInstance */
+	static void ApplyWeaponAnimation(USkeletalMeshComponent* CharacterMesh, const TSubclassOf<UAnimInstance>& AnimInstanceClass, const TSubclassOf<UAnimInstance>& AnimLayerClass);
+
 	/** Returns true if the character already owns a weapon of the given class */
 	AShooterWeapon* FindWeaponOfType(TSubclassOf<AShooterWeapon> WeaponClass) const;
 
@@ -177,11 +187,24 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category="Shooter", meta = (DisplayName = "On Death"))
 	void BP_OnDeath();
 
-	/** Called from the respawn timer to destroy this character and force the PC to respawn */
+	/** Called from the respawn timer to reuse this character or destroy it and force the PC to respawn */
 	void OnRespawn();
 
+	/** Undoes the ragdoll and death camera set up by the death Blueprint */
+	void ClearDeathState();
+
+	/** Called to allow Blueprint code to undo death effects after this character is reused */
+	UFUNCTION(BlueprintImplementableEvent, Category="Shooter", meta = (DisplayName = "On Respawned"))
+	void BP_OnRespawned();
+
 public:
 
+	/** Brings this character back to life at the given transform without respawning the actor. Returns false if it couldn't be moved there */
+	bool ResetForRespawn(const FTransform& SpawnTransform);
+
 	/** Returns true if the character is dead */
 	bool IsDead() const;
+
+	/** Returns the team ID for this character */
+	uint8 GetTeamByte() const { return TeamByte; }
 };
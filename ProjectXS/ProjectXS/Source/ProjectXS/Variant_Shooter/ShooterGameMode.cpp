@@ -10,9 +10,18 @@ void AShooterGameMode::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// create the UI
-	ShooterUI = CreateWidget<UShooterUI>(UGameplayStatics::GetPlayerController(GetWorld(), 0), ShooterUIClass);
-	ShooterUI->AddToViewport(0);
+#if !UE_SERVER
+	// create the UI. Dedicated servers have no local player to show it to
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		ShooterUI = CreateWidget<UShooterUI>(UGameplayStatics::GetPlayerController(GetWorld(), 0), ShooterUIClass);
+
+		if (ShooterUI)
+		{
+			ShooterUI->AddToViewport(0);
+		}
+	}
+#endif
 }
 
 void AShooterGameMode::IncrementTeamScore(uint8 TeamByte)
@@ -29,5 +38,8 @@ void AShooterGameMode::IncrementTeamScore(uint8 TeamByte)
 	TeamScores.Add(TeamByte, Score);
 
 	// update the UI
-	ShooterUI->BP_UpdateScore(TeamByte, Score);
+	if (ShooterUI)
+	{
+		ShooterUI->BP_UpdateScore(TeamByte, Score);
+	}
 }
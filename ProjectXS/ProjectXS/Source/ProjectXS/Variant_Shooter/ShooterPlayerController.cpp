@@ -5,10 +5,10 @@
 #include "EnhancedInputSubsystems.h"
 #include "Engine/LocalPlayer.h"
 #include "InputMappingContext.h"
-#include "Kismet/GameplayStatics.h"
-#include "GameFramework/PlayerStart.h"
 #include "ShooterCharacter.h"
+#include "ShooterSpawnSubsystem.h"
 #include "ShooterBulletCounterUI.h"
+#include "ShooterHUDModel.h"
 #include "ProjectXS.h"
 #include "Widgets/Input/SVirtualJoystick.h"
 
@@ -16,6 +16,7 @@ void AShooterPlayerController::BeginPlay()
 {
 	Super::BeginPlay();
 
+#if !UE_SERVER
 	// only spawn touch controls on local player controllers
 	if (IsLocalPlayerController())
 	{
@@ -43,6 +44,10 @@ void AShooterPlayerController::BeginPlay()
 		{
 			BulletCounterUI->AddToPlayerScreen(0);
 
+			// route HUD updates through the model
+			HUDModel = NewObject<UShooterHUDModel>(this);
+			HUDModel->SetBulletCounterUI(BulletCounterUI);
+
 		} else {
 
 			UE_LOG(LogProjectXS, Error, TEXT("Could not spawn bullet counter widget."));
@@ -50,6 +55,7 @@ void AShooterPlayerController::BeginPlay()
 		}
 		
 	}
+#endif
 }
 
 void AShooterPlayerController::SetupInputComponent()
@@ -104,23 +110,27 @@ void AShooterPlayerController::OnPossess(APawn* InPawn)
 void AShooterPlayerController::OnPawnDestroyed(AActor* DestroyedActor)
 {
 	// reset the bullet counter HUD
-	if (IsValid(BulletCounterUI))
+	if (HUDModel)
 	{
-		BulletCounterUI->BP_UpdateBulletCounter(0, 0);
+		HUDModel->SetBulletCount(0, 0);
 	}
 
-	// find the player start
-	TArray<AActor*> ActorList;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), APlayerStart::StaticClass(), ActorList);
+	// get the team of the destroyed pawn so we can avoid its enemies
+	uint8 TeamByte = 0;
 
-	if (ActorList.Num() > 0)
+	if (const AShooterCharacter* DestroyedCharacter = Cast<AShooterCharacter>(DestroyedActor))
 	{
-		// select a random player start
-		AActor* RandomPlayerStart = ActorList[FMath::RandRange(0, ActorList.Num() - 1)];
+		TeamByte = DestroyedCharacter->GetTeamByte();
+	}
 
-		// spawn a character at the player start
-		const FTransform SpawnTransform = RandomPlayerStart->GetActorTransform();
+	// ask the spawn registry for the safest player start
+	UShooterSpawnSubsystem* SpawnSubsystem = GetWorld()->GetSubsystem<UShooterSpawnSubsystem>();
 
+	FTransform SpawnTransform;
+
+	if (SpawnSubsystem && SpawnSubsystem->GetBestSpawnTransform(TeamByte, SpawnTransform))
+	{
+		// spawn a character at the player start
 		if (AShooterCharacter* RespawnedCharacter = GetWorld()->SpawnActor<AShooterCharacter>(CharacterClass, SpawnTransform))
 		{
 			// possess the character
@@ -129,20 +139,49 @@ void AShooterPlayerController::OnPawnDestroyed(AActor* DestroyedActor)
 	}
 }
 
+bool AShooterPlayerController::RespawnPawnInPlace(AShooterCharacter* DeadCharacter)
+{
+	// only reuse our own pawn
+	if (!bReusePawnOnRespawn || !IsValid(DeadCharacter) || DeadCharacter != GetPawn())
+	{
+		return false;
+	}
+
+	UShooterSpawnSubsystem* SpawnSubsystem = GetWorld()->GetSubsystem<UShooterSpawnSubsystem>();
+
+	FTransform SpawnTransform;
+
+	if (!SpawnSubsystem || !SpawnSubsystem->GetBestSpawnTransform(DeadCharacter->GetTeamByte(), SpawnTransform))
+	{
+		return false;
+	}
+
+	// reset the character at the new spawn point
+	if (!DeadCharacter->ResetForRespawn(SpawnTransform))
+	{
+		return false;
+	}
+
+	// face the spawn direction
+	SetControlRotation(SpawnTransform.Rotator());
+
+	return true;
+}
+
 void AShooterPlayerController::OnBulletCountUpdated(int32 MagazineSize, int32 Bullets)
 {
-	// update the UI
-	if (BulletCounterUI)
+	// queue the UI update, the model pushes it at most once per frame
+	if (HUDModel)
 	{
-		BulletCounterUI->BP_UpdateBulletCounter(MagazineSize, Bullets);
+		HUDModel->SetBulletCount(MagazineSize, Bullets);
 	}
 }
 
 void AShooterPlayerController::OnPawnDamaged(float LifePercent)
 {
-	if (IsValid(BulletCounterUI))
+	if (HUDModel)
 	{
-		BulletCounterUI->BP_Damaged(LifePercent);
+		HUDModel->NotifyDamaged(LifePercent);
 	}
 }
 
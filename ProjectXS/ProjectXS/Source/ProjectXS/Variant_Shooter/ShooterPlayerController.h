@@ -9,6 +9,7 @@
 class UInputMappingContext;
 class AShooterCharacter;
 class UShooterBulletCounterUI;
+class UShooterHUDModel;
 
 /**
  *  Simple PlayerController for a first person shooter game
@@ -46,6 +47,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Shooter|Respawn")
 	TSubclassOf<AShooterCharacter> CharacterClass;
 
+	/** If true, dead characters are reset and moved to a spawn point instead of being destroyed and respawned */
+	UPROPERTY(EditAnywhere, Category="Shooter|Respawn")
+	bool bReusePawnOnRespawn = true;
+
 	/** Type of bullet counter UI widget to spawn */
 	UPROPERTY(EditAnywhere, Category="Shooter|UI")
 	TSubclassOf<UShooterBulletCounterUI> BulletCounterUIClass;
@@ -58,6 +63,10 @@ protected:
 	UPROPERTY()
 	TObjectPtr<UShooterBulletCounterUI> BulletCounterUI;
 
+	/** Coalesces HUD updates so the bullet counter widget is updated at most once per frame */
+	UPROPERTY()
+	TObjectPtr<UShooterHUDModel> HUDModel;
+
 protected:
 
 	/** Gameplay Initialization */
@@ -83,4 +92,9 @@ protected:
 
 	/** Returns true if the player should use UMG touch controls */
 	bool ShouldUseTouchControls() const;
+
+public:
+
+	/** Resets the dead character and moves it to a spawn point. Returns false if the character should be destroyed instead */
+	bool RespawnPawnInPlace(AShooterCharacter* DeadCharacter);
 };
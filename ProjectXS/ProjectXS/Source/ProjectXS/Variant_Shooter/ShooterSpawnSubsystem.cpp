@@ -0,0 +1,195 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterSpawnSubsystem.h"
+#include "ShooterCharacter.h"
+#include "ShooterNPC.h"
+#include "GameFramework/PlayerStart.h"
+#include "Engine/World.h"
+#include "Engine/OverlapResult.h"
+#include "EngineUtils.h"
+
+void UShooterSpawnSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// register all player starts once
+	for (TActorIterator<APlayerStart> It(&InWorld); It; ++It)
+	{
+		RegisterPlayerStart(*It);
+	}
+}
+
+void UShooterSpawnSubsystem::RegisterPlayerStart(APlayerStart* PlayerStart)
+{
+	if (!IsValid(PlayerStart))
+	{
+		return;
+	}
+
+	// skip duplicates
+	const bool bAlreadyRegistered = SpawnPoints.ContainsByPredicate([PlayerStart](const FShooterSpawnPoint& SpawnPoint)
+	{
+		return SpawnPoint.PlayerStart == PlayerStart;
+	});
+
+	if (!bAlreadyRegistered)
+	{
+		FShooterSpawnPoint& SpawnPoint = SpawnPoints.AddDefaulted_GetRef();
+		SpawnPoint.PlayerStart = PlayerStart;
+		SpawnPoint.Transform = PlayerStart->GetActorTransform();
+	}
+}
+
+bool UShooterSpawnSubsystem::GetBestSpawnTransform(uint8 TeamByte, FTransform& OutTransform)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	int32 BestIndex = INDEX_NONE;
+	float BestThreat = TNumericLimits<float>::Max();
+
+	for (int32 i = 0; i < SpawnPoints.Num(); ++i)
+	{
+		// add a small random bias to break ties between equally safe points
+		const float Threat = GetThreatForTeam(SpawnPoints[i], TeamByte, Now) + FMath::FRand() * 0.01f;
+
+		if (Threat < BestThreat)
+		{
+			BestThreat = Threat;
+			BestIndex = i;
+		}
+	}
+
+	if (BestIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FShooterSpawnPoint& BestPoint = SpawnPoints[BestIndex];
+	BestPoint.LastUsedTime = Now;
+
+	OutTransform = BestPoint.Transform;
+	return true;
+}
+
+void UShooterSpawnSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// amortize the scoring over several frames
+	const int32 NumToScore = FMath::Min(PointsScoredPerTick, SpawnPoints.Num());
+
+	for (int32 i = 0; i < NumToScore; ++i)
+	{
+		NextScoredIndex = (NextScoredIndex + 1) % SpawnPoints.Num();
+		ScoreSpawnPoint(SpawnPoints[NextScoredIndex]);
+	}
+}
+
+TStatId UShooterSpawnSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterSpawnSubsystem, STATGROUP_Tickables);
+}
+
+void UShooterSpawnSubsystem::ScoreSpawnPoint(FShooterSpawnPoint& SpawnPoint) const
+{
+	SpawnPoint.ThreatByTeam.Reset();
+
+	UWorld* World = GetWorld();
+	const FVector PointLocation = SpawnPoint.Transform.GetLocation();
+	const FVector EyeLocation = PointLocation + FVector::UpVector * EyeHeight;
+
+	// find the pawns near the spawn point
+	TArray<FOverlapResult> Overlaps;
+
+	FCollisionObjectQueryParams ObjectParams;
+	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+
+	World->OverlapMultiByObjectType(Overlaps, PointLocation, FQuat::Identity, ObjectParams, FCollisionShape::MakeSphere(ThreatRadius));
+
+	int32 TracesLeft = MaxTracesPerPoint;
+
+	// a pawn may overlap with both its capsule and its mesh
+	TArray<const AActor*, TInlineAllocator<16>> ScoredActors;
+
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		const AActor* OverlapActor = Overlap.GetActor();
+
+		uint8 ThreatTeam = 0;
+		if (!GetLivingShooterTeam(OverlapActor, ThreatTeam) || ScoredActors.Contains(OverlapActor))
+		{
+			continue;
+		}
+
+		ScoredActors.Add(OverlapActor);
+
+		// closer pawns are more threatening
+		const float Distance = FVector::Dist(PointLocation, OverlapActor->GetActorLocation());
+		float Threat = 1.0f - FMath::Clamp(Distance / ThreatRadius, 0.0f, 1.0f);
+
+		// pawns that can see the spawn point are much more threatening
+		if (TracesLeft > 0)
+		{
+			--TracesLeft;
+
+			FCollisionQueryParams QueryParams;
+			QueryParams.AddIgnoredActor(OverlapActor);
+
+			FHitResult OutHit;
+			const FVector ViewLocation = Cast<APawn>(OverlapActor)->GetPawnViewLocation();
+
+			if (!World->LineTraceSingleByChannel(OutHit, ViewLocation, EyeLocation, ECC_Visibility, QueryParams))
+			{
+				Threat += LineOfSightThreat;
+			}
+		}
+
+		SpawnPoint.ThreatByTeam.FindOrAdd(ThreatTeam) += Threat;
+	}
+}
+
+float UShooterSpawnSubsystem::GetThreatForTeam(const FShooterSpawnPoint& SpawnPoint, uint8 TeamByte, double Now) const
+{
+	// skip points whose player start is gone
+	if (!SpawnPoint.PlayerStart.IsValid())
+	{
+		return TNumericLimits<float>::Max();
+	}
+
+	float Threat = 0.0f;
+
+	// add up the threat from every other team
+	for (const TPair<uint8, float>& TeamThreat : SpawnPoint.ThreatByTeam)
+	{
+		if (TeamThreat.Key != TeamByte)
+		{
+			Threat += TeamThreat.Value;
+		}
+	}
+
+	// avoid stacking respawns on the same point
+	if (Now - SpawnPoint.LastUsedTime < RecentUseTime)
+	{
+		Threat += RecentUseThreat;
+	}
+
+	return Threat;
+}
+
+bool UShooterSpawnSubsystem::GetLivingShooterTeam(const AActor* Actor, uint8& OutTeam)
+{
+	if (const AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(Actor))
+	{
+		OutTeam = ShooterCharacter->GetTeamByte();
+		return !ShooterCharacter->IsDead();
+	}
+
+	if (const AShooterNPC* ShooterNPC = Cast<AShooterNPC>(Actor))
+	{
+		OutTeam = ShooterNPC->GetTeamByte();
+		return !ShooterNPC->IsDead();
+	}
+
+	return false;
+}
@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterSpawnSubsystem.generated.h"
+
+class APlayerStart;
+
+/**
+ *  Registered respawn location and its cached threat score
+ */
+struct FShooterSpawnPoint
+{
+	/** Player start this point was registered from */
+	TWeakObjectPtr<APlayerStart> PlayerStart;
+
+	/** Cached spawn transform */
+	FTransform Transform;
+
+	/** Threat to this point from each team, refreshed by the amortized scoring pass */
+	TMap<uint8, float> ThreatByTeam;
+
+	/** Last time this point was used to respawn a pawn */
+	double LastUsedTime = -1.0e9;
+};
+
+/**
+ *  Keeps a flat registry of player starts for the shooter game
+ *  Scores a few points per frame for nearby living enemies and their line of sight,
+ *  so respawn requests can return the safest cached point without scanning the world
+ */
+UCLASS(config="Game")
+class PROJECTXS_API UShooterSpawnSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Number of spawn points re-scored each frame */
+	UPROPERTY(Config)
+	int32 PointsScoredPerTick = 2;
+
+	/** Radius around a spawn point to look for threats */
+	UPROPERTY(Config)
+	float ThreatRadius = 3000.0f;
+
+	/** Extra threat added for an enemy with line of sight to the spawn point */
+	UPROPERTY(Config)
+	float LineOfSightThreat = 2.0f;
+
+	/** Max line of sight traces per scored point */
+	UPROPERTY(Config)
+	int32 MaxTracesPerPoint = 4;
+
+	/** Time during which a recently used point is penalized */
+	UPROPERTY(Config)
+	float RecentUseTime = 5.0f;
+
+	/** Penalty for a recently used point */
+	UPROPERTY(Config)
+	float RecentUseThreat = 1.5f;
+
+	/** Height above the spawn point used for line of sight checks */
+	UPROPERTY(Config)
+	float EyeHeight = 60.0f;
+
+	/** Registered spawn points */
+	TArray<FShooterSpawnPoint> SpawnPoints;
+
+	/** Next point to score */
+	int32 NextScoredIndex = 0;
+
+public:
+
+	/** Registers all player starts in the world */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Registers a single player start */
+	void RegisterPlayerStart(APlayerStart* PlayerStart);
+
+	/** Returns the safest spawn transform for the given team. Returns false if there are no spawn points */
+	bool GetBestSpawnTransform(uint8 TeamByte, FTransform& OutTransform);
+
+	//~Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return SpawnPoints.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	//~End FTickableGameObject interface
+
+protected:
+
+	/** Refreshes the cached threat for a spawn point */
+	void ScoreSpawnPoint(FShooterSpawnPoint& SpawnPoint) const;
+
+	/** Returns the threat to the given team at a spawn point */
+	float GetThreatForTeam(const FShooterSpawnPoint& SpawnPoint, uint8 TeamByte, double Now) const;
+
+	/** Returns true if the actor is a living shooter pawn, and its team */
+	static bool GetLivingShooterTeam(const AActor* Actor, uint8& OutTeam);
+};
@@ -2,4 +2,19 @@
 
 
 #include "ShooterBulletCounterUI.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/InvalidationBox.h"
+
+void UShooterBulletCounterUI::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	// cache the counter's draw data. The HUD model pushes at most one update per frame to invalidate it
+	if (WidgetTree && WidgetTree->RootWidget && !WidgetTree->RootWidget->IsA<UInvalidationBox>())
+	{
+		UInvalidationBox* InvalidationBox = WidgetTree->ConstructWidget<UInvalidationBox>(UInvalidationBox::StaticClass(), TEXT("BulletCounterInvalidationBox"));
+		InvalidationBox->SetContent(WidgetTree->RootWidget);
+		WidgetTree->RootWidget = InvalidationBox;
+	}
+}
 
@@ -8,6 +8,7 @@
 
 /**
  *  Simple bullet counter UI widget for a first person shooter game
+ *  Its widget tree is wrapped in an invalidation box, so it only repaints when an update comes in
  */
 UCLASS(abstract)
 class PROJECTXS_API UShooterBulletCounterUI : public UUserWidget
@@ -23,4 +24,9 @@ public:
 	/** Allows Blueprint to update sub-widgets with the new life total and play a damage effect on the HUD */
 	UFUNCTION(BlueprintImplementableEvent, Category="Shooter", meta=(DisplayName = "Damaged"))
 	void BP_Damaged(float LifePercent);
+
+protected:
+
+	/** Wraps the widget tree in an invalidation box */
+	virtual void NativeOnInitialized() override;
 };
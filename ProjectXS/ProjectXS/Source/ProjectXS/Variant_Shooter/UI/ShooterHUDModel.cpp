@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterHUDModel.h"
+#include "ShooterBulletCounterUI.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+void UShooterHUDModel::SetBulletCounterUI(UShooterBulletCounterUI* InBulletCounterUI)
+{
+	BulletCounterUI = InBulletCounterUI;
+
+	// make sure the new widget gets the current state
+	ShownMagazineSize = -1;
+	ShownBulletCount = -1;
+
+	ScheduleFlush();
+}
+
+void UShooterHUDModel::SetBulletCount(int32 InMagazineSize, int32 InBulletCount)
+{
+	MagazineSize = InMagazineSize;
+	BulletCount = InBulletCount;
+
+	ScheduleFlush();
+}
+
+void UShooterHUDModel::NotifyDamaged(float InLifePercent)
+{
+	LifePercent = InLifePercent;
+	bDamagedPending = true;
+
+	ScheduleFlush();
+}
+
+UWorld* UShooterHUDModel::GetWorld() const
+{
+	// the CDO has no world
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return nullptr;
+	}
+
+	return GetOuter() ? GetOuter()->GetWorld() : nullptr;
+}
+
+void UShooterHUDModel::ScheduleFlush()
+{
+	if (bFlushPending)
+	{
+		return;
+	}
+
+	if (UWorld* World = GetWorld())
+	{
+		bFlushPending = true;
+		World->GetTimerManager().SetTimerForNextTick(this, &UShooterHUDModel::Flush);
+	}
+}
+
+void UShooterHUDModel::Flush()
+{
+	bFlushPending = false;
+
+	if (!IsValid(BulletCounterUI))
+	{
+		return;
+	}
+
+	// only run the widget's Blueprint when the shown count actually changes
+	if (MagazineSize != ShownMagazineSize || BulletCount != ShownBulletCount)
+	{
+		ShownMagazineSize = MagazineSize;
+		ShownBulletCount = BulletCount;
+
+		BulletCounterUI->BP_UpdateBulletCounter(MagazineSize, BulletCount);
+	}
+
+	// any number of hits this frame play a single damage effect with the latest life total
+	if (bDamagedPending)
+	{
+		bDamagedPending = false;
+
+		BulletCounterUI->BP_Damaged(LifePercent);
+	}
+}
@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "ShooterHUDModel.generated.h"
+
+class UShooterBulletCounterUI;
+
+/**
+ *  Native model behind the shooter HUD
+ *  Collects bullet count and damage changes during the frame and pushes them to the
+ *  bullet counter widget at most once per frame, skipping values the widget already shows.
+ *  Keeps full auto fire and multi pellet hits from running the widget's Blueprint events per bullet.
+ */
+UCLASS()
+class PROJECTXS_API UShooterHUDModel : public UObject
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Widget the model pushes to */
+	UPROPERTY()
+	TObjectPtr<UShooterBulletCounterUI> BulletCounterUI;
+
+	/** Latest magazine size */
+	int32 MagazineSize = 0;
+
+	/** Latest bullet count */
+	int32 BulletCount = 0;
+
+	/** Latest life percent */
+	float LifePercent = 1.0f;
+
+	/** Magazine size the widget currently shows. -1 forces the first push */
+	int32 ShownMagazineSize = -1;
+
+	/** Bullet count the widget currently shows. -1 forces the first push */
+	int32 ShownBulletCount = -1;
+
+	/** True if the pawn was damaged since the last push */
+	bool bDamagedPending = false;
+
+	/** True if a flush is scheduled for the next tick */
+	bool bFlushPending = false;
+
+public:
+
+	/** Sets the widget to push to */
+	void SetBulletCounterUI(UShooterBulletCounterUI* InBulletCounterUI);
+
+	/** Updates the bullet count */
+	void SetBulletCount(int32 InMagazineSize, int32 InBulletCount);
+
+	/** Updates the life percent and plays the damage effect */
+	void NotifyDamaged(float InLifePercent);
+
+	/** Routes the world through the owning player controller, needed for the flush timer */
+	virtual UWorld* GetWorld() const override;
+
+protected:
+
+	/** Schedules a flush for the next tick, once per frame */
+	void ScheduleFlush();
+
+	/** Pushes the frame's changes to the widget */
+	void Flush();
+};
@@ -7,6 +7,7 @@
 #include "Components/StaticMeshComponent.h"
 #include "ShooterWeaponHolder.h"
 #include "ShooterWeapon.h"
+#include "ShooterPickupSubsystem.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 
@@ -42,24 +43,67 @@ void AShooterPickup::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
 
-	if (FWeaponTableRow* WeaponData = WeaponType.GetRow<FWeaponTableRow>(FString()))
+#if WITH_EDITOR
+	// game worlds stream the mesh asynchronously on BeginPlay, only preview it in the editor
+	if (GetWorld() && GetWorld()->IsGameWorld())
 	{
-		// set the mesh
-		Mesh->SetStaticMesh(WeaponData->StaticMesh.LoadSynchronous());
+		return;
 	}
+
+	// the saved mesh component stays empty, the mesh is only set once it's streamed in
+	Mesh->SetStaticMesh(nullptr);
+
+	// preview the mesh on a transient component instead
+	if (!PreviewMesh)
+	{
+		PreviewMesh = NewObject<UStaticMeshComponent>(this, NAME_None, RF_Transient | RF_TextExportTransient | RF_DuplicateTransient);
+		PreviewMesh->bIsEditorOnly = true;
+		PreviewMesh->SetCollisionProfileName(FName("NoCollision"));
+		PreviewMesh->SetupAttachment(Mesh);
+		PreviewMesh->RegisterComponent();
+	}
+
+	const FWeaponTableRow* WeaponData = WeaponType.GetRow<FWeaponTableRow>(FString());
+	PreviewMesh->SetStaticMesh(WeaponData ? WeaponData->StaticMesh.LoadSynchronous() : nullptr);
+#endif
 }
 
 void AShooterPickup::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (FWeaponTableRow* WeaponData = WeaponType.GetRow<FWeaponTableRow>(FString()))
+	// keep the pickup hidden and non-interactive until its assets are streamed in
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	if (UShooterPickupSubsystem* PickupSubsystem = GetWorld()->GetSubsystem<UShooterPickupSubsystem>())
 	{
-		// copy the weapon class
-		WeaponClass = WeaponData->WeaponToSpawn;
+		PickupSubsystem->RequestPickupAssets(this, WeaponType);
 	}
 }
 
+void AShooterPickup::OnPickupAssetsLoaded(UStaticMesh* LoadedMesh, TSubclassOf<AShooterWeapon> LoadedWeaponClass)
+{
+	bAssetsLoaded = true;
+
+	// set the mesh and weapon class
+	Mesh->SetStaticMesh(LoadedMesh);
+	WeaponClass = LoadedWeaponClass;
+
+	// don't enable the pickup if it's waiting to respawn
+	if (GetWorld()->GetTimerManager().IsTimerActive(RespawnTimer))
+	{
+		return;
+	}
+
+	// show the pickup
+	SetActorHiddenInGame(false);
+
+	// enable collision and tick
+	FinishRespawn();
+}
+
 void AShooterPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
@@ -70,6 +114,12 @@ void AShooterPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 void AShooterPickup::OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+	// ignore overlaps until the weapon class is available
+	if (!bAssetsLoaded)
+	{
+		return;
+	}
+
 	// have we collided against a weapon holder?
 	if (IShooterWeaponHolder* WeaponHolder = Cast<IShooterWeaponHolder>(OtherActor))
 	{
@@ -26,7 +26,7 @@ struct FWeaponTableRow : public FTableRowBase
 
 	/** Weapon class to grant on pickup */
 	UPROPERTY(EditAnywhere)
-	TSubclassOf<AShooterWeapon> WeaponToSpawn;
+	TSoftClassPtr<AShooterWeapon> WeaponToSpawn;
 };
 
 /**
@@ -44,6 +44,12 @@ class PROJECTXS_API AShooterPickup : public AActor
 	/** Weapon pickup mesh. Its mesh asset is set from the weapon data table */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UStaticMeshComponent* Mesh;
+
+#if WITH_EDITORONLY_DATA
+	/** Editor preview of the pickup mesh. Never saved, so placed pickups don't keep a hard reference to the mesh */
+	UPROPERTY(Transient)
+	TObjectPtr<UStaticMeshComponent> PreviewMesh;
+#endif
 	
 protected:
 
@@ -61,11 +67,17 @@ protected:
 	/** Timer to respawn the pickup */
 	FTimerHandle RespawnTimer;
 
+	/** True once the pickup's mesh and weapon class have been streamed in */
+	bool bAssetsLoaded = false;
+
 public:	
 	
 	/** Constructor */
 	AShooterPickup();
 
+	/** Called by the pickup subsystem once the mesh and weapon class are loaded. Enables the pickup */
+	void OnPickupAssetsLoaded(UStaticMesh* LoadedMesh, TSubclassOf<AShooterWeapon> LoadedWeaponClass);
+
 protected:
 
 	/** Native construction script */
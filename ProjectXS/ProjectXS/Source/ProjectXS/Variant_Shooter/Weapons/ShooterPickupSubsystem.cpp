@@ -0,0 +1,159 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterPickupSubsystem.h"
+#include "ShooterPickup.h"
+#include "ShooterWeapon.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+void UShooterPickupSubsystem::RequestPickupAssets(AShooterPickup* Pickup, const FDataTableRowHandle& WeaponType)
+{
+	if (!Pickup)
+	{
+		return;
+	}
+
+	const FRowKey Key(FObjectKey(WeaponType.DataTable), WeaponType.RowName);
+
+	FResolvedRow* Row = ResolvedRows.Find(Key);
+
+	// first request for this row, resolve it once
+	if (!Row)
+	{
+		Row = &ResolvedRows.Add(Key);
+
+		if (const FWeaponTableRow* WeaponData = WeaponType.GetRow<FWeaponTableRow>(FString()))
+		{
+			Row->MeshAsset = WeaponData->StaticMesh;
+			Row->WeaponAsset = WeaponData->WeaponToSpawn;
+		}
+	}
+
+	// already loaded, hand the assets over right away
+	if (Row->bLoaded)
+	{
+		NotifyPickup(Pickup, *Row);
+		return;
+	}
+
+	Row->WaitingPickups.Add(Pickup);
+
+	// the row is already part of a request
+	if (Row->bLoading)
+	{
+		return;
+	}
+
+	Row->bLoading = true;
+	PendingRows.Add(Key);
+
+	// batch all requests made this frame into a single load
+	if (!bFlushScheduled)
+	{
+		bFlushScheduled = true;
+		GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UShooterPickupSubsystem::FlushPendingRequests));
+	}
+}
+
+void UShooterPickupSubsystem::Deinitialize()
+{
+	// release all loaded assets
+	for (const TSharedPtr<FStreamableHandle>& Handle : LoadHandles)
+	{
+		if (Handle.IsValid())
+		{
+			Handle->ReleaseHandle();
+		}
+	}
+
+	LoadHandles.Empty();
+	ResolvedRows.Empty();
+	PendingRows.Empty();
+
+	Super::Deinitialize();
+}
+
+void UShooterPickupSubsystem::FlushPendingRequests()
+{
+	bFlushScheduled = false;
+
+	if (PendingRows.IsEmpty())
+	{
+		return;
+	}
+
+	// gather the unique asset paths for every pending row
+	TArray<FSoftObjectPath> AssetPaths;
+
+	for (const FRowKey& Key : PendingRows)
+	{
+		const FResolvedRow& Row = ResolvedRows.FindChecked(Key);
+
+		if (!Row.MeshAsset.IsNull())
+		{
+			AssetPaths.AddUnique(Row.MeshAsset.ToSoftObjectPath());
+		}
+
+		if (!Row.WeaponAsset.IsNull())
+		{
+			AssetPaths.AddUnique(Row.WeaponAsset.ToSoftObjectPath());
+		}
+	}
+
+	TArray<FRowKey> RequestedRows = MoveTemp(PendingRows);
+	PendingRows.Reset();
+
+	// nothing to load, complete right away
+	if (AssetPaths.IsEmpty())
+	{
+		OnBatchLoaded(MoveTemp(RequestedRows));
+		return;
+	}
+
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+
+	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
+		MoveTemp(AssetPaths),
+		FStreamableDelegate::CreateUObject(this, &UShooterPickupSubsystem::OnBatchLoaded, MoveTemp(RequestedRows)),
+		FStreamableManager::AsyncLoadHighPriority);
+
+	if (Handle.IsValid())
+	{
+		LoadHandles.Add(Handle);
+	}
+}
+
+void UShooterPickupSubsystem::OnBatchLoaded(TArray<FRowKey> LoadedRows)
+{
+	for (const FRowKey& Key : LoadedRows)
+	{
+		FResolvedRow* Row = ResolvedRows.Find(Key);
+		if (!Row)
+		{
+			continue;
+		}
+
+		Row->bLoading = false;
+		Row->bLoaded = true;
+
+		// hand the assets to every pickup waiting on this row
+		TArray<TWeakObjectPtr<AShooterPickup>> Waiting = MoveTemp(Row->WaitingPickups);
+
+		for (const TWeakObjectPtr<AShooterPickup>& Pickup : Waiting)
+		{
+			NotifyPickup(Pickup.Get(), *Row);
+		}
+	}
+}
+
+void UShooterPickupSubsystem::NotifyPickup(AShooterPickup* Pickup, const FResolvedRow& Row)
+{
+	if (IsValid(Pickup))
+	{
+		Pickup->OnPickupAssetsLoaded(Row.MeshAsset.Get(), Row.WeaponAsset.Get());
+	}
+}
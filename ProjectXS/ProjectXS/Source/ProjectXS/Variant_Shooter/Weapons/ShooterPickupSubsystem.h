@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/DataTable.h"
+#include "UObject/ObjectKey.h"
+#include "ShooterPickupSubsystem.generated.h"
+
+class AShooterPickup;
+class AShooterWeapon;
+class UStaticMesh;
+struct FStreamableHandle;
+
+/**
+ *  Streams weapon pickup assets for a level
+ *  Pickups registered in the same frame are resolved against their data table once per row
+ *  and loaded through a single batched async request. Resolved rows are cached and shared
+ */
+UCLASS()
+class PROJECTXS_API UShooterPickupSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Key for a data table row */
+	using FRowKey = TTuple<FObjectKey, FName>;
+
+	/** Resolved pickup row, shared by every pickup using it */
+	struct FResolvedRow
+	{
+		/** soft mesh reference from the table row */
+		TSoftObjectPtr<UStaticMesh> MeshAsset;
+
+		/** soft weapon class reference from the table row */
+		TSoftClassPtr<AShooterWeapon> WeaponAsset;
+
+		/** true once the assets have finished loading */
+		bool bLoaded = false;
+
+		/** true while the assets are part of an in-flight request */
+		bool bLoading = false;
+
+		/** pickups waiting on this row */
+		TArray<TWeakObjectPtr<AShooterPickup>> WaitingPickups;
+	};
+
+	/** Resolved rows */
+	TMap<FRowKey, FResolvedRow> ResolvedRows;
+
+	/** Rows waiting to be included in the next batched request */
+	TArray<FRowKey> PendingRows;
+
+	/** Handles for all requests made in this world. Keeps loaded assets alive */
+	TArray<TSharedPtr<FStreamableHandle>> LoadHandles;
+
+	/** True if a batched request is already scheduled for this frame */
+	bool bFlushScheduled = false;
+
+public:
+
+	/** Requests the assets for a pickup. The pickup is notified once they're loaded, immediately if already cached */
+	void RequestPickupAssets(AShooterPickup* Pickup, const FDataTableRowHandle& WeaponType);
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+protected:
+
+	/** Issues a single async load for every row requested this frame */
+	void FlushPendingRequests();
+
+	/** Called when a batched load completes */
+	void OnBatchLoaded(TArray<FRowKey> LoadedRows);
+
+	/** Notifies a pickup that its row is available */
+	static void NotifyPickup(AShooterPickup* Pickup, const FResolvedRow& Row);
+};
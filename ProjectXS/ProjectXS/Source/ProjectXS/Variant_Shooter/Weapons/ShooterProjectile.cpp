@@ -12,6 +12,7 @@
 #include "Engine/OverlapResult.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "ProjectXSStats.h"
 
 AShooterProjectile::AShooterProjectile()
 {
@@ -39,6 +40,9 @@ AShooterProjectile::AShooterProjectile()
 void AShooterProjectile::BeginPlay()
 {
 	Super::BeginPlay();
+
+	XS_INC_COUNTER(STAT_XS_ProjectilesSpawned, 1);
+	INC_DWORD_STAT(STAT_XS_ProjectilesAlive);
 	
 	// ignore the pawn that shot this projectile
 	CollisionComponent->IgnoreActorWhenMoving(GetInstigator(), true);
@@ -48,12 +52,16 @@ void AShooterProjectile::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	DEC_DWORD_STAT(STAT_XS_ProjectilesAlive);
+
 	// clear the destruction timer
 	GetWorld()->GetTimerManager().ClearTimer(DestructionTimer);
 }
 
 void AShooterProjectile::NotifyHit(class UPrimitiveComponent* MyComp, AActor* Other, class UPrimitiveComponent* OtherComp, bool bSelfMoved, FVector HitLocation, FVector HitNormal, FVector NormalImpulse, const FHitResult& Hit)
 {
+	XS_SCOPE_CYCLE_COUNTER(STAT_XS_ProjectileHit);
+
 	// ignore if we've already hit something else
 	if (bHit)
 	{
@@ -98,6 +106,9 @@ void AShooterProjectile::NotifyHit(class UPrimitiveComponent* MyComp, AActor* Ot
 
 void AShooterProjectile::ExplosionCheck(const FVector& ExplosionCenter)
 {
+	XS_SCOPE_CYCLE_COUNTER(STAT_XS_ProjectileExplosion);
+	XS_INC_TRACES(1);
+
 	// do a sphere overlap check look for nearby actors to damage
 	TArray<FOverlapResult> Overlaps;
 
@@ -148,6 +159,7 @@ void AShooterProjectile::ProcessHit(AActor* HitActor, UPrimitiveComponent* HitCo
 		if (HitCharacter != GetOwner() || bDamageOwner)
 		{
 			// apply damage to the character
+			XS_INC_COUNTER(STAT_XS_DamageEvents, 1);
 			UGameplayStatics::ApplyDamage(HitCharacter, HitDamage, GetInstigator()->GetController(), this, HitDamageType);
 		}
 	}
@@ -123,6 +123,25 @@ void AShooterWeapon::StopFiring()
 	GetWorld()->GetTimerManager().ClearTimer(RefireTimer);
 }
 
+void AShooterWeapon::ResetWeapon()
+{
+	// stop firing and clear the refire timer
+	StopFiring();
+
+	// refill the magazine
+	CurrentBullets = MagazineSize;
+}
+
+void AShooterWeapon::DisableFirstPersonMesh()
+{
+	if (FirstPersonMesh)
+	{
+		// free the mesh, its bone buffers and tick
+		FirstPersonMesh->DestroyComponent();
+		FirstPersonMesh = nullptr;
+	}
+}
+
 void AShooterWeapon::Fire()
 {
 	// ensure the player still wants to fire. They may have let go of the trigger
@@ -153,6 +172,11 @@ void AShooterWeapon::Fire()
 	}
 }
 
+bool AShooterWeapon::IsRefirePending() const
+{
+	return bIsFiring && GetWorld()->GetTimerManager().IsTimerActive(RefireTimer);
+}
+
 void AShooterWeapon::FireCooldownExpired()
 {
 	// notify the owner
@@ -195,18 +219,29 @@ void AShooterWeapon::FireProjectile(const FVector& TargetLocation)
 FTransform AShooterWeapon::CalculateProjectileSpawnTransform(const FVector& TargetLocation) const
 {
 	// find the muzzle location
-	const FVector MuzzleLoc = FirstPersonMesh->GetSocketLocation(MuzzleSocketName);
+	const FVector MuzzleLoc = GetMuzzleMesh()->GetSocketLocation(MuzzleSocketName);
+
+	return CalculateProjectileSpawnTransform(MuzzleLoc, TargetLocation, MuzzleOffset, AimVariance);
+}
 
+FTransform AShooterWeapon::CalculateProjectileSpawnTransform(const FVector& MuzzleLoc, const FVector& TargetLocation, float InMuzzleOffset, float InAimVariance)
+{
 	// calculate the spawn location ahead of the muzzle
-	const FVector SpawnLoc = MuzzleLoc + ((TargetLocation - MuzzleLoc).GetSafeNormal() * MuzzleOffset);
+	const FVector SpawnLoc = MuzzleLoc + ((TargetLocation - MuzzleLoc).GetSafeNormal() * InMuzzleOffset);
 
 	// find the aim rotation vector while applying some variance to the target 
-	const FRotator AimRot = UKismetMathLibrary::FindLookAtRotation(SpawnLoc, TargetLocation + (UKismetMathLibrary::RandomUnitVector() * AimVariance));
+	const FRotator AimRot = UKismetMathLibrary::FindLookAtRotation(SpawnLoc, TargetLocation + (UKismetMathLibrary::RandomUnitVector() * InAimVariance));
 
 	// return the built transform
 	return FTransform(AimRot, SpawnLoc, FVector::OneVector);
 }
 
+USkeletalMeshComponent* AShooterWeapon::GetMuzzleMesh() const
+{
+	// fall back to the third person mesh if the first person one was disabled
+	return FirstPersonMesh ? FirstPersonMesh : ThirdPersonMesh;
+}
+
 const TSubclassOf<UAnimInstance>& AShooterWeapon::GetFirstPersonAnimInstanceClass() const
 {
 	return FirstPersonAnimInstanceClass;
@@ -61,6 +61,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Animation")
 	TSubclassOf<UAnimInstance> ThirdPersonAnimInstanceClass;
 
+	/** Optional anim layers to link on the first person character mesh. Used instead of swapping the AnimInstance class */
+	UPROPERTY(EditAnywhere, Category="Animation")
+	TSubclassOf<UAnimInstance> FirstPersonAnimLayerClass;
+
+	/** Optional anim layers to link on the third person character mesh. Used instead of swapping the AnimInstance class */
+	UPROPERTY(EditAnywhere, Category="Animation")
+	TSubclassOf<UAnimInstance> ThirdPersonAnimLayerClass;
+
 	/** Cone half-angle for variance while aiming */
 	UPROPERTY(EditAnywhere, Category="Aim", meta = (ClampMin = 0, ClampMax = 90, Units = "Degrees"))
 	float AimVariance = 0.0f;
@@ -142,6 +150,12 @@ public:
 	/** Stop firing this weapon */
 	void StopFiring();
 
+	/** Stops firing and refills the magazine so the weapon can be reused after the owner respawns */
+	void ResetWeapon();
+
+	/** Destroys the first person mesh for owners that don't have a first person view */
+	void DisableFirstPersonMesh();
+
 protected:
 
 	/** Fire the weapon */
@@ -158,7 +172,23 @@ protected:
 
 public:
 
-	/** Returns the first person mesh */
+	/** Calculates a projectile spawn transform ahead of the muzzle, aimed at the target with random variance */
+	static FTransform CalculateProjectileSpawnTransform(const FVector& MuzzleLocation, const FVector& TargetLocation, float InMuzzleOffset, float InAimVariance);
+
+protected:
+
+	/** Returns the mesh holding the muzzle socket */
+	USkeletalMeshComponent* GetMuzzleMesh() const;
+
+public:
+
+	/** Returns the time between shots */
+	float GetRefireRate() const { return RefireRate; }
+
+	/** Returns true if the weapon is waiting to refire */
+	bool IsRefirePending() const;
+
+	/** Returns the first person mesh. Null if it was disabled */
 	UFUNCTION(BlueprintPure, Category="Weapon")
 	USkeletalMeshComponent* GetFirstPersonMesh() const { return FirstPersonMesh; };
 
@@ -172,6 +202,12 @@ public:
 	/** Returns the third person anim instance class */
 	const TSubclassOf<UAnimInstance>& GetThirdPersonAnimInstanceClass() const;
 
+	/** Returns the first person anim layer class */
+	const TSubclassOf<UAnimInstance>& GetFirstPersonAnimLayerClass() const { return FirstPersonAnimLayerClass; }
+
+	/** Returns the third person anim layer class */
+	const TSubclassOf<UAnimInstance>& GetThirdPersonAnimLayerClass() const { return ThirdPersonAnimLayerClass; }
+
 	/** Returns the magazine size */
 	int32 GetMagazineSize() const { return MagazineSize; };
 
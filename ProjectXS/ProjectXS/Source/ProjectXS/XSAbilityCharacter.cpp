@@ -3,6 +3,7 @@
 #include "XSAbilityCharacter.h"
 #include "AbilitySystemComponent.h"
 #include "XSAttributeSet.h"
+#include "XSAttributeObserverComponent.h"
 #include "XSWeaponBase.h"
 #include "Abilities/GameplayAbility.h"
 #include "GameplayEffect.h"
@@ -20,6 +21,9 @@ AXSAbilityCharacter::AXSAbilityCharacter()
 	// Create attribute set
 	AttributeSet = CreateDefaultSubobject<UXSAttributeSet>(TEXT("AttributeSet"));
 
+	// Create attribute observer
+	AttributeObserver = CreateDefaultSubobject<UXSAttributeObserverComponent>(TEXT("AttributeObserver"));
+
 	bAbilitySystemInitialized = false;
 
 	// Default character info
@@ -12,6 +12,7 @@
 #include "XSAbilityCharacter.generated.h"
 
 class UXSAttributeSet;
+class UXSAttributeObserverComponent;
 class UGameplayAbility;
 class UGameplayEffect;
 class AXSWeaponBase;
@@ -38,6 +39,10 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Abilities")
 	const UXSAttributeSet* AttributeSet;
 
+	/** Attribute change events for UI. Bind to these instead of polling the attribute getters */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Abilities")
+	UXSAttributeObserverComponent* AttributeObserver;
+
 	// ====== IAbilitySystemInterface ======
 	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
 
@@ -131,7 +136,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Abilities")
 	bool ActivateAbilityByTag(const FGameplayTag& AbilityTag);
 
-	/** Get attribute value */
+	/** Get attribute value. Widgets should use AttributeObserver's events rather than binding to these */
 	UFUNCTION(BlueprintPure, Category = "Abilities")
 	float GetHealth() const;
 
@@ -2,13 +2,9 @@
 
 #include "XSAbility_AreaDamage.h"
 #include "XSAbilityCharacter.h"
-#include "XSAttributeSet.h"
-#include "AbilitySystemComponent.h"
-#include "Kismet/GameplayStatics.h"
+#include "XSDamageZoneSubsystem.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/World.h"
-#include "Engine/OverlapResult.h"
-#include "TimerManager.h"
 
 UXSAbility_AreaDamage::UXSAbility_AreaDamage()
 {
@@ -23,6 +19,8 @@ UXSAbility_AreaDamage::UXSAbility_AreaDamage()
 	CastRange = 3000.0f;
 	ActivationDelay = 1.0f;
 	bUseFalloff = true;
+	DamageDuration = 0.0f;
+	DamageTickInterval = 0.5f;
 
 	bCanActivateWhileMoving = true;
 	bCanActivateInAir = false;
@@ -45,28 +43,14 @@ void UXSAbility_AreaDamage::ActivateAbility(const FGameplayAbilitySpecHandle Han
 	// Spawn projectile or indicator visuals
 	SpawnEffects(TargetLocation);
 
-	// Set timer for activation
-	if (ActivationDelay > 0.0f)
+	// Hand the damage off to the world damage zone manager, so the ability
+	// doesn't need to stay alive through the delay or a lingering damage field
+	if (HasAuthority(&ActivationInfo))
 	{
-		FVector CapturedLocation = TargetLocation;
-		FTimerDelegate TimerDelegate;
-		TimerDelegate.BindWeakLambda(this, [this, CapturedLocation]()
-		{
-			ApplyAreaDamage(CapturedLocation);
-		});
-		GetWorld()->GetTimerManager().SetTimer(ActivationTimerHandle, TimerDelegate, ActivationDelay, false);
-	}
-	else
-	{
-		ApplyAreaDamage(TargetLocation);
+		RegisterDamageZone(TargetLocation, ActivationDelay);
 	}
 
-	// End ability (the damage will apply after delay)
-	const float TotalDuration = ActivationDelay + 0.1f;
-	FTimerHandle EndTimerHandle;
-	FTimerDelegate EndDelegate;
-	EndDelegate.BindUObject(this, &UXSAbility_AreaDamage::EndAbility, Handle, ActorInfo, ActivationInfo, true, false);
-	GetWorld()->GetTimerManager().SetTimer(EndTimerHandle, EndDelegate, TotalDuration, false);
+	EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
 }
 
 FVector UXSAbility_AreaDamage::GetTargetLocation() const
@@ -97,6 +81,11 @@ FVector UXSAbility_AreaDamage::GetTargetLocation() const
 }
 
 void UXSAbility_AreaDamage::ApplyAreaDamage(const FVector& Location)
+{
+	RegisterDamageZone(Location, 0.0f);
+}
+
+void UXSAbility_AreaDamage::RegisterDamageZone(const FVector& Location, float Delay) const
 {
 	AXSAbilityCharacter* Character = GetXSCharacterFromActorInfo();
 	if (!Character)
@@ -104,58 +93,24 @@ void UXSAbility_AreaDamage::ApplyAreaDamage(const FVector& Location)
 		return;
 	}
 
-	// Find all actors in radius
-	TArray<FOverlapResult> OverlapResults;
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(Character);
-
-	GetWorld()->OverlapMultiByChannel(
-		OverlapResults,
-		Location,
-		FQuat::Identity,
-		ECC_Pawn,
-		FCollisionShape::MakeSphere(DamageRadius),
-		QueryParams
-	);
-
-	// Apply damage to each hit actor
-	for (const FOverlapResult& Overlap : OverlapResults)
+	UXSDamageZoneSubsystem* DamageZones = GetWorld()->GetSubsystem<UXSDamageZoneSubsystem>();
+	if (!DamageZones)
 	{
-		AActor* HitActor = Overlap.GetActor();
-		if (!HitActor)
-		{
-			continue;
-		}
-
-		// Calculate damage with falloff
-		float FinalDamage = AreaDamage;
-		if (bUseFalloff)
-		{
-			float Distance = FVector::Dist(Location, HitActor->GetActorLocation());
-			float FalloffMultiplier = 1.0f - (Distance / DamageRadius);
-			FinalDamage *= FMath::Max(0.0f, FalloffMultiplier);
-		}
-
-		// Apply damage
-		if (UAbilitySystemComponent* TargetASC = HitActor->FindComponentByClass<UAbilitySystemComponent>())
-		{
-			// Apply damage through GAS
-			if (const UXSAttributeSet* TargetAttributes = TargetASC->GetSet<UXSAttributeSet>())
-			{
-				TargetASC->ApplyModToAttribute(TargetAttributes->GetDamageAttribute(), EGameplayModOp::Additive, FinalDamage);
-			}
-		}
-		else
-		{
-			// Fallback to standard damage
-			UGameplayStatics::ApplyDamage(HitActor, FinalDamage, Character->GetController(), Character, nullptr);
-		}
+		return;
 	}
 
-	// Debug visualization
-	#if !UE_BUILD_SHIPPING
-	DrawDebugSphere(GetWorld(), Location, DamageRadius, 32, FColor::Orange, false, 2.0f, 0, 2.0f);
-	#endif
+	FXSDamageZone Zone;
+	Zone.Location = Location;
+	Zone.Radius = DamageRadius;
+	Zone.Damage = AreaDamage;
+	Zone.bUseFalloff = bUseFalloff;
+	Zone.ActivationDelay = Delay;
+	Zone.Duration = DamageDuration;
+	Zone.TickInterval = DamageTickInterval;
+	Zone.Instigator = Character;
+	Zone.InstigatorController = Character->GetController();
+
+	DamageZones->AddZone(Zone);
 }
 
 void UXSAbility_AreaDamage::SpawnEffects_Implementation(const FVector& Location)
@@ -164,7 +119,7 @@ void UXSAbility_AreaDamage::SpawnEffects_Implementation(const FVector& Location)
 	// This base implementation does nothing
 	
 	// Debug visualization
-	#if !UE_BUILD_SHIPPING
+	#if !UE_BUILD_SHIPPING && !UE_SERVER
 	DrawDebugSphere(GetWorld(), Location, 50.0f, 16, FColor::Red, false, ActivationDelay, 0, 2.0f);
 	DrawDebugLine(GetWorld(), GetXSCharacterFromActorInfo()->GetActorLocation(), Location, FColor::Yellow, false, ActivationDelay, 0, 1.0f);
 	#endif
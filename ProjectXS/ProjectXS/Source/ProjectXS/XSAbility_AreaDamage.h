@@ -38,6 +38,14 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Area Damage")
 	bool bUseFalloff;
 
+	/** How long the area keeps dealing damage after it first applies. Zero for a single detonation */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Area Damage", meta = (ClampMin = 0))
+	float DamageDuration;
+
+	/** Time between damage applications while the area lingers */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Area Damage", meta = (ClampMin = 0.05))
+	float DamageTickInterval;
+
 protected:
 	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, 
 		const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
@@ -46,14 +54,16 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "Area Damage")
 	FVector GetTargetLocation() const;
 
-	/** Apply area damage */
+	/** Queue area damage at a location. Resolved by the world damage zone manager */
 	UFUNCTION(BlueprintCallable, Category = "Area Damage")
 	void ApplyAreaDamage(const FVector& Location);
 
+	/** Register a damage zone that applies after the given delay */
+	void RegisterDamageZone(const FVector& Location, float Delay) const;
+
 	/** Spawn visual effects */
 	UFUNCTION(BlueprintNativeEvent, Category = "Area Damage")
 	void SpawnEffects(const FVector& Location);
 
-	FTimerHandle ActivationTimerHandle;
 	FVector TargetLocation;
 };
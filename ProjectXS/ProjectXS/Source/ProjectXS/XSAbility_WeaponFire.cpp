@@ -4,11 +4,13 @@
 #include "XSAbilityCharacter.h"
 #include "XSWeaponBase.h"
 #include "XSAttributeSet.h"
+#include "XSFireLatencySubsystem.h"
 #include "AbilitySystemComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/World.h"
+#include "ProjectXSStats.h"
 
 UXSAbility_WeaponFire::UXSAbility_WeaponFire()
 {
@@ -58,6 +60,12 @@ void UXSAbility_WeaponFire::ActivateAbility(const FGameplayAbilitySpecHandle Han
 {
 	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 
+	if (UXSFireLatencySubsystem* FireLatency = GetWorld()->GetSubsystem<UXSFireLatencySubsystem>())
+	{
+		FireLatency->MarkActivation(ActorInfo->AbilitySystemComponent.Get(), ActivationInfo.GetActivationPredictionKey().Current,
+			ActorInfo->IsLocallyControlled(), ActorInfo->IsNetAuthority());
+	}
+
 	// Fire weapon
 	FireWeapon();
 
@@ -67,6 +75,8 @@ void UXSAbility_WeaponFire::ActivateAbility(const FGameplayAbilitySpecHandle Han
 
 void UXSAbility_WeaponFire::FireWeapon()
 {
+	XS_SCOPE_CYCLE_COUNTER(STAT_XS_FireWeapon);
+
 	AXSWeaponBase* Weapon = GetWeaponFromActorInfo();
 	if (!Weapon)
 	{
@@ -104,13 +114,15 @@ void UXSAbility_WeaponFire::FireWeapon()
 		}
 	}
 
-	// Play fire effects
+	// Queue fire effects, played once per frame through the weapon's effect batch
 	FVector EndLocation = MuzzleLocation + (FiringDirection * Weapon->MaxRange);
-	Weapon->PlayFireEffects(MuzzleLocation, EndLocation);
+	Weapon->AddPendingFire(MuzzleLocation, EndLocation);
 }
 
 void UXSAbility_WeaponFire::PerformHitscan(const FVector& StartLocation, const FVector& Direction)
 {
+	XS_SCOPE_CYCLE_COUNTER(STAT_XS_Hitscan);
+
 	AXSWeaponBase* Weapon = GetWeaponFromActorInfo();
 	AXSAbilityCharacter* Character = GetXSCharacterFromActorInfo();
 	
@@ -122,6 +134,8 @@ void UXSAbility_WeaponFire::PerformHitscan(const FVector& StartLocation, const F
 	FVector EndLocation = StartLocation + (Direction * Weapon->MaxRange);
 
 	// Perform line trace
+	XS_INC_TRACES(1);
+
 	FHitResult HitResult;
 	FCollisionQueryParams QueryParams;
 	QueryParams.AddIgnoredActor(Character);
@@ -137,14 +151,24 @@ void UXSAbility_WeaponFire::PerformHitscan(const FVector& StartLocation, const F
 		QueryParams
 	);
 
+	if (UXSFireLatencySubsystem* FireLatency = GetWorld()->GetSubsystem<UXSFireLatencySubsystem>())
+	{
+		const FGameplayAbilityActorInfo* ActorInfo = GetCurrentActorInfo();
+		FireLatency->MarkHit(ActorInfo->AbilitySystemComponent.Get(), GetCurrentActivationInfo().GetActivationPredictionKey().Current,
+			bHit ? HitResult.GetActor() : nullptr, ActorInfo->IsLocallyControlled(), ActorInfo->IsNetAuthority());
+	}
+
 	if (bHit)
 	{
 		// Apply damage to hit actor
 		float Damage = Weapon->BaseDamage * DamageMultiplier;
 		ApplyDamage(HitResult.GetActor(), Damage, HitResult.ImpactPoint);
 
+		// Impact effects are packed into the weapon's per-frame batch
+		Weapon->AddPendingImpact(HitResult.ImpactPoint, HitResult.ImpactNormal);
+
 		// Debug draw
-		#if !UE_BUILD_SHIPPING
+		#if !UE_BUILD_SHIPPING && !UE_SERVER
 		DrawDebugLine(GetWorld(), StartLocation, HitResult.ImpactPoint, FColor::Red, false, 2.0f, 0, 1.0f);
 		DrawDebugSphere(GetWorld(), HitResult.ImpactPoint, 5.0f, 8, FColor::Red, false, 2.0f);
 		#endif
@@ -152,7 +176,7 @@ void UXSAbility_WeaponFire::PerformHitscan(const FVector& StartLocation, const F
 	else
 	{
 		// Debug draw miss
-		#if !UE_BUILD_SHIPPING
+		#if !UE_BUILD_SHIPPING && !UE_SERVER
 		DrawDebugLine(GetWorld(), StartLocation, EndLocation, FColor::Green, false, 2.0f, 0, 1.0f);
 		#endif
 	}
@@ -183,11 +207,15 @@ void UXSAbility_WeaponFire::SpawnProjectile(const FVector& StartLocation, const
 
 void UXSAbility_WeaponFire::ApplyDamage(AActor* HitActor, float Damage, const FVector& HitLocation)
 {
+	XS_SCOPE_CYCLE_COUNTER(STAT_XS_ApplyDamage);
+
 	if (!HitActor)
 	{
 		return;
 	}
 
+	XS_INC_COUNTER(STAT_XS_DamageEvents, 1);
+
 	AXSAbilityCharacter* Character = GetXSCharacterFromActorInfo();
 	if (!Character)
 	{
@@ -219,6 +247,16 @@ void UXSAbility_WeaponFire::ApplyDamage(AActor* HitActor, float Damage, const FV
 		// Fallback to standard damage system
 		UGameplayStatics::ApplyDamage(HitActor, Damage, Character->GetController(), Character, nullptr);
 	}
+
+	// Damage lands right away, so this shot's measurement ends here. Other damage sources aren't counted
+	const FGameplayAbilityActorInfo* ActorInfo = GetCurrentActorInfo();
+	if (ActorInfo->IsNetAuthority())
+	{
+		if (UXSFireLatencySubsystem* FireLatency = GetWorld()->GetSubsystem<UXSFireLatencySubsystem>())
+		{
+			FireLatency->MarkDamageApplied(ActorInfo->AbilitySystemComponent.Get(), GetCurrentActivationInfo().GetActivationPredictionKey().Current);
+		}
+	}
 }
 
 FVector UXSAbility_WeaponFire::GetFiringDirection() const
@@ -257,13 +295,23 @@ FVector UXSAbility_WeaponFire::GetMuzzleLocation() const
 
 FVector UXSAbility_WeaponFire::ApplySpread(const FVector& Direction) const
 {
-	if (!bUseSpread || MaxSpreadAngle <= 0.0f)
+	if (!bUseSpread)
+	{
+		return Direction;
+	}
+
+	return CalculateSpreadDirection(Direction, MaxSpreadAngle);
+}
+
+FVector UXSAbility_WeaponFire::CalculateSpreadDirection(const FVector& Direction, float SpreadAngle)
+{
+	if (SpreadAngle <= 0.0f)
 	{
 		return Direction;
 	}
 
 	// Random spread within cone
-	float RandomAngle = FMath::FRandRange(0.0f, MaxSpreadAngle);
+	float RandomAngle = FMath::FRandRange(0.0f, SpreadAngle);
 	float RandomRotation = FMath::FRandRange(0.0f, 360.0f);
 
 	FRotator SpreadRotation = FRotator(
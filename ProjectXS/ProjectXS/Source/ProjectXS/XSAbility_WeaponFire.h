@@ -67,4 +67,9 @@ protected:
 
 	/** Apply spread to direction */
 	FVector ApplySpread(const FVector& Direction) const;
+
+public:
+
+	/** Returns the direction rotated by a random spread of up to SpreadAngle degrees */
+	static FVector CalculateSpreadDirection(const FVector& Direction, float SpreadAngle);
 };
@@ -0,0 +1,242 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "XSAttributeObserverComponent.h"
+#include "XSAttributeSet.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+UXSAttributeObserverComponent::UXSAttributeObserverComponent()
+{
+	// Event driven, never ticks
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UXSAttributeObserverComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Owners with their own ability system are observed automatically
+	if (UAbilitySystemComponent* OwnerAbilitySystem = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetOwner()))
+	{
+		ObserveAbilitySystem(OwnerAbilitySystem);
+	}
+}
+
+void UXSAttributeObserverComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopObserving();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UXSAttributeObserverComponent::ObserveAbilitySystem(UAbilitySystemComponent* InAbilitySystem)
+{
+	if (InAbilitySystem == AbilitySystem)
+	{
+		return;
+	}
+
+	StopObserving();
+
+	AbilitySystem = InAbilitySystem;
+
+	if (!AbilitySystem)
+	{
+		return;
+	}
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EXSObservedAttribute::Num); ++Index)
+	{
+		const FGameplayAttribute Attribute = GetGameplayAttribute(static_cast<EXSObservedAttribute>(Index));
+
+		ChangeHandles[Index] = AbilitySystem->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(this, &UXSAttributeObserverComponent::OnAttributeValueChanged);
+		BroadcastValues[Index] = AbilitySystem->GetNumericAttribute(Attribute);
+	}
+}
+
+void UXSAttributeObserverComponent::StopObserving()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(BroadcastTimer);
+	}
+
+	if (AbilitySystem)
+	{
+		for (uint8 Index = 0; Index < static_cast<uint8>(EXSObservedAttribute::Num); ++Index)
+		{
+			const FGameplayAttribute Attribute = GetGameplayAttribute(static_cast<EXSObservedAttribute>(Index));
+			AbilitySystem->GetGameplayAttributeValueChangeDelegate(Attribute).Remove(ChangeHandles[Index]);
+			ChangeHandles[Index].Reset();
+		}
+	}
+
+	AbilitySystem = nullptr;
+	PendingMask = 0;
+}
+
+void UXSAttributeObserverComponent::OnAttributeValueChanged(const FOnAttributeChangeData& Data)
+{
+	for (uint8 Index = 0; Index < static_cast<uint8>(EXSObservedAttribute::Num); ++Index)
+	{
+		if (Data.Attribute == GetGameplayAttribute(static_cast<EXSObservedAttribute>(Index)))
+		{
+			PendingMask |= 1u << Index;
+			ScheduleBroadcast();
+			return;
+		}
+	}
+}
+
+void UXSAttributeObserverComponent::ScheduleBroadcast()
+{
+	UWorld* World = GetWorld();
+	FTimerManager& TimerManager = World->GetTimerManager();
+
+	// Already scheduled, the pending mask picks up this change
+	if (TimerManager.TimerExists(BroadcastTimer))
+	{
+		return;
+	}
+
+	const double Delay = LastBroadcastTime < 0.0 ? 0.0 : LastBroadcastTime + UpdateInterval - World->GetTimeSeconds();
+
+	if (Delay > 0.0)
+	{
+		TimerManager.SetTimer(BroadcastTimer, this, &UXSAttributeObserverComponent::BroadcastPending, static_cast<float>(Delay), false);
+	}
+	else
+	{
+		BroadcastTimer = TimerManager.SetTimerForNextTick(this, &UXSAttributeObserverComponent::BroadcastPending);
+	}
+}
+
+void UXSAttributeObserverComponent::BroadcastPending()
+{
+	BroadcastTimer.Invalidate();
+
+	if (!AbilitySystem || PendingMask == 0)
+	{
+		return;
+	}
+
+	LastBroadcastTime = GetWorld()->GetTimeSeconds();
+
+	// Copy first, listeners may change attributes and schedule the next broadcast
+	const uint32 Mask = PendingMask;
+	PendingMask = 0;
+
+	// Current and max changes are collected so each pair event fires once per broadcast
+	uint32 ChangedMask = 0;
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EXSObservedAttribute::Num); ++Index)
+	{
+		if (Mask & (1u << Index))
+		{
+			const EXSObservedAttribute Attribute = static_cast<EXSObservedAttribute>(Index);
+			const float NewValue = GetAttributeValue(Attribute);
+			const float OldValue = BroadcastValues[Index];
+
+			// Changes that cancelled out within the interval are dropped
+			if (NewValue != OldValue)
+			{
+				BroadcastValues[Index] = NewValue;
+				ChangedMask |= 1u << Index;
+				BroadcastAttribute(Attribute, NewValue, OldValue);
+			}
+		}
+	}
+
+	BroadcastPairs(ChangedMask);
+}
+
+void UXSAttributeObserverComponent::BroadcastAll()
+{
+	if (!AbilitySystem)
+	{
+		return;
+	}
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EXSObservedAttribute::Num); ++Index)
+	{
+		const EXSObservedAttribute Attribute = static_cast<EXSObservedAttribute>(Index);
+		const float Value = GetAttributeValue(Attribute);
+
+		BroadcastValues[Index] = Value;
+		BroadcastAttribute(Attribute, Value, Value);
+	}
+
+	BroadcastPairs(TNumericLimits<uint32>::Max());
+}
+
+void UXSAttributeObserverComponent::BroadcastAttribute(EXSObservedAttribute Attribute, float NewValue, float OldValue)
+{
+	OnAttributeChanged.Broadcast(Attribute, NewValue, OldValue);
+
+	// Current and max pairs are broadcast by BroadcastPairs
+	switch (Attribute)
+	{
+	case EXSObservedAttribute::EnergyRegenRate:
+		OnEnergyRegenRateChanged.Broadcast(NewValue);
+		break;
+
+	case EXSObservedAttribute::MoveSpeed:
+		OnMoveSpeedChanged.Broadcast(NewValue);
+		break;
+
+	default:
+		break;
+	}
+}
+
+void UXSAttributeObserverComponent::BroadcastPairs(uint32 ChangedMask)
+{
+	const auto HasChanged = [ChangedMask](EXSObservedAttribute Attribute)
+	{
+		return (ChangedMask & (1u << static_cast<uint8>(Attribute))) != 0;
+	};
+
+	if (HasChanged(EXSObservedAttribute::Health) || HasChanged(EXSObservedAttribute::MaxHealth))
+	{
+		OnHealthChanged.Broadcast(GetAttributeValue(EXSObservedAttribute::Health), GetAttributeValue(EXSObservedAttribute::MaxHealth));
+	}
+
+	if (HasChanged(EXSObservedAttribute::Energy) || HasChanged(EXSObservedAttribute::MaxEnergy))
+	{
+		OnEnergyChanged.Broadcast(GetAttributeValue(EXSObservedAttribute::Energy), GetAttributeValue(EXSObservedAttribute::MaxEnergy));
+	}
+}
+
+float UXSAttributeObserverComponent::GetAttributeValue(EXSObservedAttribute Attribute) const
+{
+	return AbilitySystem ? AbilitySystem->GetNumericAttribute(GetGameplayAttribute(Attribute)) : 0.0f;
+}
+
+FGameplayAttribute UXSAttributeObserverComponent::GetGameplayAttribute(EXSObservedAttribute Attribute)
+{
+	switch (Attribute)
+	{
+	case EXSObservedAttribute::Health:
+		return UXSAttributeSet::GetHealthAttribute();
+
+	case EXSObservedAttribute::MaxHealth:
+		return UXSAttributeSet::GetMaxHealthAttribute();
+
+	case EXSObservedAttribute::Energy:
+		return UXSAttributeSet::GetEnergyAttribute();
+
+	case EXSObservedAttribute::MaxEnergy:
+		return UXSAttributeSet::GetMaxEnergyAttribute();
+
+	case EXSObservedAttribute::EnergyRegenRate:
+		return UXSAttributeSet::GetEnergyRegenRateAttribute();
+
+	case EXSObservedAttribute::MoveSpeed:
+		return UXSAttributeSet::GetMoveSpeedAttribute();
+
+	default:
+		return FGameplayAttribute();
+	}
+}
@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/TimerHandle.h"
+#include "XSAttributeObserverComponent.generated.h"
+
+class UAbilitySystemComponent;
+struct FGameplayAttribute;
+struct FOnAttributeChangeData;
+
+/**
+ * Attributes of UXSAttributeSet that can be observed
+ */
+UENUM(BlueprintType)
+enum class EXSObservedAttribute : uint8
+{
+	Health			UMETA(DisplayName = "Health"),
+	MaxHealth		UMETA(DisplayName = "Max Health"),
+	Energy			UMETA(DisplayName = "Energy"),
+	MaxEnergy		UMETA(DisplayName = "Max Energy"),
+	EnergyRegenRate	UMETA(DisplayName = "Energy Regen Rate"),
+	MoveSpeed		UMETA(DisplayName = "Move Speed"),
+	Num				UMETA(Hidden)
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FXSAttributeChangedDelegate, EXSObservedAttribute, Attribute, float, NewValue, float, OldValue);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FXSAttributePairChangedDelegate, float, Current, float, Max);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FXSAttributeValueChangedDelegate, float, Value);
+
+/**
+ * Turns UXSAttributeSet changes into events for UI and gameplay code
+ * Subscribes once to the owner's ability system for every attribute, collects the changes
+ * and broadcasts them at most once per UpdateInterval. Widgets bound to these events instead of
+ * polling the character's attribute getters stay idle while nothing changes.
+ */
+UCLASS(ClassGroup = "Abilities", meta = (BlueprintSpawnableComponent))
+class PROJECTXS_API UXSAttributeObserverComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UXSAttributeObserverComponent();
+
+	// ====== Events ======
+
+	/** Any observed attribute changed. Old value is the value at the previous broadcast */
+	UPROPERTY(BlueprintAssignable, Category = "Attributes")
+	FXSAttributeChangedDelegate OnAttributeChanged;
+
+	/** Health or max health changed */
+	UPROPERTY(BlueprintAssignable, Category = "Attributes")
+	FXSAttributePairChangedDelegate OnHealthChanged;
+
+	/** Energy or max energy changed */
+	UPROPERTY(BlueprintAssignable, Category = "Attributes")
+	FXSAttributePairChangedDelegate OnEnergyChanged;
+
+	/** Energy regen rate changed */
+	UPROPERTY(BlueprintAssignable, Category = "Attributes")
+	FXSAttributeValueChangedDelegate OnEnergyRegenRateChanged;
+
+	/** Move speed changed */
+	UPROPERTY(BlueprintAssignable, Category = "Attributes")
+	FXSAttributeValueChangedDelegate OnMoveSpeedChanged;
+
+	// ====== Settings ======
+
+	/** Minimum time between broadcasts. Zero broadcasts at most once per frame */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Attributes", meta = (ClampMin = 0, Units = "s"))
+	float UpdateInterval = 0.0f;
+
+	// ====== Methods ======
+
+	/** Subscribes to an ability system. Called automatically for owners implementing IAbilitySystemInterface */
+	void ObserveAbilitySystem(UAbilitySystemComponent* InAbilitySystem);
+
+	/** Broadcasts every attribute with its current value, e.g. to initialize a newly created widget */
+	UFUNCTION(BlueprintCallable, Category = "Attributes")
+	void BroadcastAll();
+
+	/** Returns the current value of an attribute */
+	UFUNCTION(BlueprintPure, Category = "Attributes")
+	float GetAttributeValue(EXSObservedAttribute Attribute) const;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Called by the ability system whenever an observed attribute changes */
+	void OnAttributeValueChanged(const FOnAttributeChangeData& Data);
+
+	/** Schedules a broadcast, respecting the update interval */
+	void ScheduleBroadcast();
+
+	/** Broadcasts the attributes changed since the last broadcast */
+	void BroadcastPending();
+
+	/** Broadcasts the single attribute events */
+	void BroadcastAttribute(EXSObservedAttribute Attribute, float NewValue, float OldValue);
+
+	/** Broadcasts each current and max pair event once if either of its attributes is in the mask */
+	void BroadcastPairs(uint32 ChangedMask);
+
+	/** Unsubscribes from the observed ability system */
+	void StopObserving();
+
+	/** Returns the gameplay attribute for an observed attribute */
+	static FGameplayAttribute GetGameplayAttribute(EXSObservedAttribute Attribute);
+
+	/** Ability system being observed */
+	UPROPERTY()
+	TObjectPtr<UAbilitySystemComponent> AbilitySystem;
+
+	/** Change delegate handles by attribute */
+	FDelegateHandle ChangeHandles[static_cast<uint8>(EXSObservedAttribute::Num)];
+
+	/** Values at the previous broadcast, by attribute */
+	float BroadcastValues[static_cast<uint8>(EXSObservedAttribute::Num)] = {};
+
+	/** Bit per attribute changed since the last broadcast */
+	uint32 PendingMask = 0;
+
+	/** World time of the last broadcast */
+	double LastBroadcastTime = -1.0;
+
+	/** Scheduled broadcast */
+	FTimerHandle BroadcastTimer;
+};
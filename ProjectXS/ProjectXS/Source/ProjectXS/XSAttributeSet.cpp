@@ -6,6 +6,9 @@
 #include "Net/UnrealNetwork.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "ProjectXSStats.h"
+#include "XSFireLatencySubsystem.h"
+#include "AbilitySystemComponent.h"
 
 UXSAttributeSet::UXSAttributeSet()
 {
@@ -49,6 +52,8 @@ void UXSAttributeSet::PreAttributeChange(const FGameplayAttribute& Attribute, fl
 
 void UXSAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
 {
+	XS_SCOPE_CYCLE_COUNTER(STAT_XS_PostGameplayEffectExecute);
+
 	Super::PostGameplayEffectExecute(Data);
 
 	FGameplayEffectContextHandle Context = Data.EffectSpec.GetContext();
@@ -118,6 +123,12 @@ void UXSAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutL
 void UXSAttributeSet::OnRep_Health(const FGameplayAttributeData& OldHealth)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UXSAttributeSet, Health, OldHealth);
+
+	// End of the fire latency measurement for shots that hit this actor
+	if (UXSFireLatencySubsystem* FireLatency = GetWorld()->GetSubsystem<UXSFireLatencySubsystem>())
+	{
+		FireLatency->MarkHealthReplicated(GetOwningAbilitySystemComponentChecked()->GetAvatarActor());
+	}
 }
 
 void UXSAttributeSet::OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth)
@@ -168,9 +179,13 @@ void UXSAttributeSet::AdjustAttributeForMaxChange(FGameplayAttributeData& Affect
 	if (!FMath::IsNearlyEqual(CurrentMaxValue, NewMaxValue) && AbilityComp)
 	{
 		// Change current value to maintain the same ratio
-		const float CurrentValue = AffectedAttribute.GetCurrentValue();
-		float NewDelta = (CurrentMaxValue > 0.0f) ? (CurrentValue * NewMaxValue / CurrentMaxValue) - CurrentValue : NewMaxValue;
+		const float NewDelta = CalculateMaxChangeDelta(AffectedAttribute.GetCurrentValue(), CurrentMaxValue, NewMaxValue);
 
 		AbilityComp->ApplyModToAttributeUnsafe(AffectedAttributeProperty, EGameplayModOp::Additive, NewDelta);
 	}
 }
+
+float UXSAttributeSet::CalculateMaxChangeDelta(float CurrentValue, float CurrentMaxValue, float NewMaxValue)
+{
+	return (CurrentMaxValue > 0.0f) ? (CurrentValue * NewMaxValue / CurrentMaxValue) - CurrentValue : NewMaxValue;
+}
@@ -90,4 +90,9 @@ protected:
 
 	// Helper to clamp attribute values
 	void AdjustAttributeForMaxChange(FGameplayAttributeData& AffectedAttribute, const FGameplayAttributeData& MaxAttribute, float NewMaxValue, const FGameplayAttribute& AffectedAttributeProperty);
+
+public:
+
+	/** Returns the change to a value that keeps its ratio to the max when the max changes */
+	static float CalculateMaxChangeDelta(float CurrentValue, float CurrentMaxValue, float NewMaxValue);
 };
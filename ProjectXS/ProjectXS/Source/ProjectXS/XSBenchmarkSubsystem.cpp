@@ -0,0 +1,568 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "XSBenchmarkSubsystem.h"
+#include "XSAbilityCharacter.h"
+#include "ShooterNPC.h"
+#include "ShooterNPCSpawner.h"
+#include "ShooterNPCPoolSubsystem.h"
+#include "ProjectXSStats.h"
+#include "AbilitySystemComponent.h"
+#include "NavigationSystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProjectXS.h"
+
+namespace XSBenchmark
+{
+	/** Height above the navmesh at which pawns are spawned */
+	constexpr float SpawnHeight = 100.0f;
+
+	/** Tag the shooter NPCs look for when sensing enemies */
+	const FName PlayerTag = FName("Player");
+
+	/** Exit code for a run with no baseline to compare to */
+	constexpr int32 MissingBaselineExitCode = 2;
+
+	/** Exit code for a run that regressed past the baseline */
+	constexpr int32 RegressionExitCode = 3;
+}
+
+bool UXSBenchmarkSubsystem::IsBenchmarkRequested()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("XSBenchmark"));
+}
+
+bool UXSBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && IsBenchmarkRequested();
+}
+
+bool UXSBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UXSBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Command line overrides for the config defaults
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FParse::Value(CommandLine, TEXT("XSBenchmarkNPCs="), NumNPCs);
+	FParse::Value(CommandLine, TEXT("XSBenchmarkBots="), NumBots);
+	FParse::Value(CommandLine, TEXT("XSBenchmarkWarmup="), WarmupTime);
+	FParse::Value(CommandLine, TEXT("XSBenchmarkDuration="), Duration);
+	FParse::Value(CommandLine, TEXT("XSBenchmarkSeed="), Seed);
+	FParse::Value(CommandLine, TEXT("XSBenchmarkTolerance="), Tolerance);
+	FParse::Value(CommandLine, TEXT("XSBenchmarkBaseline="), BaselinePath);
+
+	bWriteBaseline = FParse::Param(CommandLine, TEXT("XSBenchmarkWriteBaseline"));
+
+	FString BotClassList;
+	if (FParse::Value(CommandLine, TEXT("XSBenchmarkBotClasses="), BotClassList, false))
+	{
+		TArray<FString> BotClassPaths;
+		BotClassList.ParseIntoArray(BotClassPaths, TEXT(","));
+
+		BotClasses.Reset();
+
+		for (const FString& BotClassPath : BotClassPaths)
+		{
+			BotClasses.Add(TSoftClassPtr<AXSAbilityCharacter>(FSoftObjectPath(BotClassPath)));
+		}
+	}
+
+	NumNPCs = FMath::Max(0, NumNPCs);
+	NumBots = FMath::Max(0, NumBots);
+	Duration = FMath::Max(1.0f, Duration);
+}
+
+void UXSBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Seed the global and local generators so placement, spread and AI choices repeat between runs
+	FMath::RandInit(Seed);
+	FMath::SRandInit(Seed);
+	RandomStream.Initialize(Seed);
+
+	for (TActorIterator<AShooterNPCSpawner> It(&InWorld); It; ++It)
+	{
+		// The benchmark owns the NPC count, keep the level's own spawn timers out of the measurement
+		It->DisableSpawning();
+
+		if (IsValid(It->GetNPCClass()))
+		{
+			Spawners.Add(*It);
+		}
+	}
+
+	if (Spawners.IsEmpty())
+	{
+		UE_LOG(LogProjectXS, Error, TEXT("XSBenchmark: no NPC spawners in %s, nothing to measure"), *UGameplayStatics::GetCurrentLevelName(this));
+		Phase = EXSBenchmarkPhase::Finished;
+		FPlatformMisc::RequestExitWithStatus(false, 1);
+		return;
+	}
+
+	// Iterate spawners in a stable order
+	Spawners.Sort([](const TWeakObjectPtr<AShooterNPCSpawner>& A, const TWeakObjectPtr<AShooterNPCSpawner>& B)
+	{
+		return A->GetName() < B->GetName();
+	});
+
+	// Load the bot classes up front so the warmup is not spent streaming
+	TArray<UClass*> LoadedBotClasses;
+
+	for (const TSoftClassPtr<AXSAbilityCharacter>& BotClass : BotClasses)
+	{
+		if (UClass* LoadedClass = BotClass.LoadSynchronous())
+		{
+			LoadedBotClasses.Add(LoadedClass);
+		}
+	}
+
+	// Without bots nothing shoots, and the run would gate an idle scenario
+	if (NumBots > 0 && LoadedBotClasses.IsEmpty())
+	{
+		UE_LOG(LogProjectXS, Error, TEXT("XSBenchmark: no bot classes could be loaded. Set BotClasses in DefaultGame.ini or pass -XSBenchmarkBotClasses="));
+		Phase = EXSBenchmarkPhase::Finished;
+		FPlatformMisc::RequestExitWithStatus(false, 1);
+		return;
+	}
+
+	for (int32 i = 0; i < NumNPCs; ++i)
+	{
+		SpawnNPC();
+	}
+
+	for (int32 i = 0; i < NumBots; ++i)
+	{
+		SpawnBot(LoadedBotClasses[i % LoadedBotClasses.Num()]);
+	}
+
+	UE_LOG(LogProjectXS, Log, TEXT("XSBenchmark: %d NPCs, %d bots, seed %d, warmup %.1fs, duration %.1fs"),
+		NPCs.Num(), Bots.Num(), Seed, WarmupTime, Duration);
+
+	Phase = EXSBenchmarkPhase::Warmup;
+	PhaseStartTime = InWorld.GetTimeSeconds();
+	NextBotFireTime = PhaseStartTime;
+}
+
+TStatId UXSBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UXSBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+void UXSBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	UpdateNPCs(Now);
+
+	if (Now >= NextBotFireTime)
+	{
+		NextBotFireTime = Now + BotFireInterval;
+		FireBots();
+	}
+
+	if (Phase == EXSBenchmarkPhase::Warmup)
+	{
+		if (Now - PhaseStartTime >= WarmupTime)
+		{
+			BeginMeasure();
+		}
+
+		return;
+	}
+
+	SampleFrame();
+
+	if (Now - PhaseStartTime >= Duration)
+	{
+		FinishBenchmark();
+	}
+}
+
+// ====== Scenario ======
+
+void UXSBenchmarkSubsystem::SpawnNPC()
+{
+	UShooterNPCPoolSubsystem* Pool = GetWorld()->GetSubsystem<UShooterNPCPoolSubsystem>();
+
+	FTransform SpawnTransform;
+	if (!Pool || !GetRandomSpawnTransform(SpawnTransform))
+	{
+		return;
+	}
+
+	// Spawners are validated on begin play, pick the class of one of them
+	const AShooterNPCSpawner* Spawner = Spawners[RandomStream.RandHelper(Spawners.Num())].Get();
+	if (!Spawner)
+	{
+		return;
+	}
+
+	if (AShooterNPC* NPC = Pool->AcquireNPC(Spawner->GetNPCClass(), SpawnTransform))
+	{
+		NPCs.Add(NPC);
+	}
+}
+
+void UXSBenchmarkSubsystem::SpawnBot(UClass* BotClass)
+{
+	FTransform SpawnTransform;
+	if (!GetRandomSpawnTransform(SpawnTransform))
+	{
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AXSAbilityCharacter* Bot = GetWorld()->SpawnActor<AXSAbilityCharacter>(BotClass, SpawnTransform, SpawnParams);
+	if (!Bot)
+	{
+		return;
+	}
+
+	// Bots need a controller to own their abilities and aim
+	if (!Bot->GetController())
+	{
+		Bot->SpawnDefaultController();
+	}
+
+	// Let the NPCs sense the bots as enemies
+	Bot->Tags.AddUnique(XSBenchmark::PlayerTag);
+
+	Bots.Add(Bot);
+}
+
+bool UXSBenchmarkSubsystem::GetRandomSpawnTransform(FTransform& OutTransform)
+{
+	const AShooterNPCSpawner* Spawner = Spawners[RandomStream.RandHelper(Spawners.Num())].Get();
+	if (!Spawner)
+	{
+		return false;
+	}
+
+	OutTransform = Spawner->GetSpawnTransform();
+
+	// Scatter around the spawner, snapped to the navmesh so pawns do not start inside geometry
+	const FVector2D Offset = FVector2D(RandomStream.FRandRange(-1.0f, 1.0f), RandomStream.FRandRange(-1.0f, 1.0f)) * SpawnScatterRadius;
+	const FVector Candidate = OutTransform.GetLocation() + FVector(Offset, 0.0f);
+
+	FNavLocation NavLocation;
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	if (NavSys && NavSys->ProjectPointToNavigation(Candidate, NavLocation))
+	{
+		OutTransform.SetLocation(NavLocation.Location + FVector::UpVector * XSBenchmark::SpawnHeight);
+	}
+
+	OutTransform.SetRotation(FRotator(0.0f, RandomStream.FRandRange(0.0f, 360.0f), 0.0f).Quaternion());
+	return true;
+}
+
+void UXSBenchmarkSubsystem::UpdateNPCs(double Now)
+{
+	// Queue a replacement for every NPC that died
+	for (int32 i = NPCs.Num() - 1; i >= 0; --i)
+	{
+		const AShooterNPC* NPC = NPCs[i].Get();
+
+		if (!IsValid(NPC) || NPC->IsDead())
+		{
+			NPCs.RemoveAtSwap(i, EAllowShrinking::No);
+			PendingNPCReplacements.Add(Now + NPCReplaceDelay);
+		}
+	}
+
+	for (int32 i = PendingNPCReplacements.Num() - 1; i >= 0; --i)
+	{
+		if (Now >= PendingNPCReplacements[i])
+		{
+			PendingNPCReplacements.RemoveAtSwap(i, EAllowShrinking::No);
+			SpawnNPC();
+		}
+	}
+}
+
+void UXSBenchmarkSubsystem::FireBots()
+{
+	for (const TWeakObjectPtr<AXSAbilityCharacter>& BotPtr : Bots)
+	{
+		AXSAbilityCharacter* Bot = BotPtr.Get();
+		if (!IsValid(Bot) || !Bot->IsAlive() || !Bot->AbilitySystemComponent)
+		{
+			continue;
+		}
+
+		// Find the closest living NPC
+		const FVector EyeLocation = Bot->GetPawnViewLocation();
+
+		const AShooterNPC* Target = nullptr;
+		double BestDistSquared = TNumericLimits<double>::Max();
+
+		for (const TWeakObjectPtr<AShooterNPC>& NPCPtr : NPCs)
+		{
+			const AShooterNPC* NPC = NPCPtr.Get();
+			if (!IsValid(NPC) || NPC->IsDead())
+			{
+				continue;
+			}
+
+			const double DistSquared = FVector::DistSquared(EyeLocation, NPC->GetActorLocation());
+			if (DistSquared < BestDistSquared)
+			{
+				BestDistSquared = DistSquared;
+				Target = NPC;
+			}
+		}
+
+		if (!Target)
+		{
+			continue;
+		}
+
+		if (AController* Controller = Bot->GetController())
+		{
+			Controller->SetControlRotation((Target->GetActorLocation() - EyeLocation).Rotation());
+		}
+
+		// Cooldowns, energy and ammo gate how often each of these actually fires
+		UAbilitySystemComponent* ASC = Bot->AbilitySystemComponent;
+
+		for (const TSubclassOf<UGameplayAbility>& Ability : { Bot->PrimaryAbility, Bot->SecondaryAbility, Bot->UltimateAbility })
+		{
+			if (Ability)
+			{
+				ASC->TryActivateAbilityByClass(Ability);
+			}
+		}
+	}
+}
+
+// ====== Measurement ======
+
+void UXSBenchmarkSubsystem::BeginMeasure()
+{
+	Phase = EXSBenchmarkPhase::Measure;
+	PhaseStartTime = GetWorld()->GetTimeSeconds();
+	LastFrameTime = FPlatformTime::Seconds();
+
+	FrameTimesMs.Reset();
+	GameThreadTimesMs.Reset();
+	PeakUsedPhysical = 0;
+	TracesIssuedAtMeasureStart = GXSTracesIssued;
+	TracesIssuedWhileMeasuring = 0;
+
+	// Memory stats are expensive to query on some platforms, sample them at a low rate
+	SampleMemory();
+	GetWorld()->GetTimerManager().SetTimer(MemorySampleTimer, this, &UXSBenchmarkSubsystem::SampleMemory, MemorySampleInterval, true);
+
+#if CSV_PROFILER
+	// Frame, thread, memory and XS counter stats for the measured window
+	const FString CsvName = FString::Printf(TEXT("%s_%s.csv"), *UGameplayStatics::GetCurrentLevelName(this), *FDateTime::Now().ToString());
+	FCsvProfiler::Get()->BeginCapture(-1, GetOutputDirectory(), CsvName);
+#endif
+
+	UE_LOG(LogProjectXS, Log, TEXT("XSBenchmark: measuring"));
+}
+
+void UXSBenchmarkSubsystem::SampleFrame()
+{
+	const double FrameTime = FPlatformTime::Seconds();
+
+	FrameTimesMs.Add(static_cast<float>((FrameTime - LastFrameTime) * 1000.0));
+	GameThreadTimesMs.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+
+	LastFrameTime = FrameTime;
+}
+
+void UXSBenchmarkSubsystem::SampleMemory()
+{
+	PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+}
+
+void UXSBenchmarkSubsystem::FinishBenchmark()
+{
+	Phase = EXSBenchmarkPhase::Finished;
+
+	GetWorld()->GetTimerManager().ClearTimer(MemorySampleTimer);
+	SampleMemory();
+
+	TracesIssuedWhileMeasuring = GXSTracesIssued - TracesIssuedAtMeasureStart;
+
+#if CSV_PROFILER
+	FCsvProfiler::Get()->EndCapture();
+#endif
+
+	const FXSBenchmarkSummary Summary = BuildSummary();
+
+	UE_LOG(LogProjectXS, Display, TEXT("XSBenchmark: %d frames, avg %.2fms, p95 %.2fms, game thread %.2fms, peak memory %.1fMB, %.1f traces per frame"),
+		Summary.NumFrames, Summary.AvgFrameMs, Summary.P95FrameMs, Summary.AvgGameThreadMs, Summary.PeakUsedPhysicalMB, Summary.AvgTracesPerFrame);
+
+	const FString SummaryPath = GetOutputDirectory() / FString::Printf(TEXT("%s_Summary.json"), *UGameplayStatics::GetCurrentLevelName(this));
+	SaveSummary(Summary, SummaryPath);
+
+	int32 ExitCode = 0;
+
+	const FString ComparePath = BaselinePath.IsEmpty() ? GetDefaultBaselinePath() : BaselinePath;
+	FXSBenchmarkSummary Baseline;
+
+	if (bWriteBaseline)
+	{
+		ExitCode = SaveSummary(Summary, ComparePath) ? 0 : 1;
+	}
+	else if (LoadSummary(ComparePath, Baseline))
+	{
+		if (!CompareToBaseline(Summary, Baseline))
+		{
+			ExitCode = XSBenchmark::RegressionExitCode;
+		}
+	}
+	else
+	{
+		// A gate without a baseline would pass every run, fail until one is recorded
+		UE_LOG(LogProjectXS, Error, TEXT("XSBenchmark: no baseline at %s. Record one with -XSBenchmarkWriteBaseline"), *ComparePath);
+		ExitCode = XSBenchmark::MissingBaselineExitCode;
+	}
+
+	FPlatformMisc::RequestExitWithStatus(false, ExitCode);
+}
+
+FXSBenchmarkSummary UXSBenchmarkSubsystem::BuildSummary() const
+{
+	FXSBenchmarkSummary Summary;
+	Summary.NumFrames = FrameTimesMs.Num();
+	Summary.PeakUsedPhysicalMB = static_cast<double>(PeakUsedPhysical) / (1024.0 * 1024.0);
+
+	if (Summary.NumFrames == 0)
+	{
+		return Summary;
+	}
+
+	Summary.AvgTracesPerFrame = static_cast<double>(TracesIssuedWhileMeasuring) / Summary.NumFrames;
+
+	double FrameSum = 0.0;
+	double GameThreadSum = 0.0;
+
+	for (int32 i = 0; i < Summary.NumFrames; ++i)
+	{
+		FrameSum += FrameTimesMs[i];
+		GameThreadSum += GameThreadTimesMs[i];
+	}
+
+	Summary.AvgFrameMs = FrameSum / Summary.NumFrames;
+	Summary.AvgGameThreadMs = GameThreadSum / Summary.NumFrames;
+
+	TArray<float> SortedFrameTimes = FrameTimesMs;
+	SortedFrameTimes.Sort();
+	Summary.P95FrameMs = SortedFrameTimes[FMath::Min(Summary.NumFrames - 1, FMath::FloorToInt(Summary.NumFrames * 0.95f))];
+
+	return Summary;
+}
+
+FString UXSBenchmarkSubsystem::GetOutputDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Benchmark");
+}
+
+FString UXSBenchmarkSubsystem::GetDefaultBaselinePath() const
+{
+	return FPaths::ProjectDir() / TEXT("Build/Benchmark") / FString::Printf(TEXT("%s_Baseline.json"), *UGameplayStatics::GetCurrentLevelName(this));
+}
+
+bool UXSBenchmarkSubsystem::SaveSummary(const FXSBenchmarkSummary& Summary, const FString& Path)
+{
+	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetNumberField(TEXT("NumFrames"), Summary.NumFrames);
+	JsonObject->SetNumberField(TEXT("AvgFrameMs"), Summary.AvgFrameMs);
+	JsonObject->SetNumberField(TEXT("P95FrameMs"), Summary.P95FrameMs);
+	JsonObject->SetNumberField(TEXT("AvgGameThreadMs"), Summary.AvgGameThreadMs);
+	JsonObject->SetNumberField(TEXT("PeakUsedPhysicalMB"), Summary.PeakUsedPhysicalMB);
+	JsonObject->SetNumberField(TEXT("AvgTracesPerFrame"), Summary.AvgTracesPerFrame);
+
+	FString Output;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+
+	if (!FJsonSerializer::Serialize(JsonObject, Writer) || !FFileHelper::SaveStringToFile(Output, *Path))
+	{
+		UE_LOG(LogProjectXS, Error, TEXT("XSBenchmark: failed to write %s"), *Path);
+		return false;
+	}
+
+	UE_LOG(LogProjectXS, Log, TEXT("XSBenchmark: wrote %s"), *Path);
+	return true;
+}
+
+bool UXSBenchmarkSubsystem::LoadSummary(const FString& Path, FXSBenchmarkSummary& OutSummary)
+{
+	FString Input;
+	if (!FFileHelper::LoadFileToString(Input, *Path))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Input);
+
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		UE_LOG(LogProjectXS, Error, TEXT("XSBenchmark: failed to parse %s"), *Path);
+		return false;
+	}
+
+	JsonObject->TryGetNumberField(TEXT("NumFrames"), OutSummary.NumFrames);
+	JsonObject->TryGetNumberField(TEXT("AvgFrameMs"), OutSummary.AvgFrameMs);
+	JsonObject->TryGetNumberField(TEXT("P95FrameMs"), OutSummary.P95FrameMs);
+	JsonObject->TryGetNumberField(TEXT("AvgGameThreadMs"), OutSummary.AvgGameThreadMs);
+	JsonObject->TryGetNumberField(TEXT("PeakUsedPhysicalMB"), OutSummary.PeakUsedPhysicalMB);
+	JsonObject->TryGetNumberField(TEXT("AvgTracesPerFrame"), OutSummary.AvgTracesPerFrame);
+
+	return true;
+}
+
+bool UXSBenchmarkSubsystem::CompareToBaseline(const FXSBenchmarkSummary& Summary, const FXSBenchmarkSummary& Baseline) const
+{
+	bool bPassed = true;
+
+	auto CompareMetric = [this, &bPassed](const TCHAR* Name, double Value, double BaselineValue)
+	{
+		// Metrics missing from the baseline are not gated
+		if (BaselineValue <= 0.0)
+		{
+			return;
+		}
+
+		const double Ratio = Value / BaselineValue;
+		const bool bRegressed = Ratio > 1.0 + Tolerance;
+
+		UE_LOG(LogProjectXS, Display, TEXT("XSBenchmark: %-20s %10.2f baseline %10.2f (%+.1f%%) %s"),
+			Name, Value, BaselineValue, (Ratio - 1.0) * 100.0, bRegressed ? TEXT("REGRESSED") : TEXT("ok"));
+
+		bPassed &= !bRegressed;
+	};
+
+	CompareMetric(TEXT("AvgFrameMs"), Summary.AvgFrameMs, Baseline.AvgFrameMs);
+	CompareMetric(TEXT("P95FrameMs"), Summary.P95FrameMs, Baseline.P95FrameMs);
+	CompareMetric(TEXT("AvgGameThreadMs"), Summary.AvgGameThreadMs, Baseline.AvgGameThreadMs);
+	CompareMetric(TEXT("PeakUsedPhysicalMB"), Summary.PeakUsedPhysicalMB, Baseline.PeakUsedPhysicalMB);
+	CompareMetric(TEXT("AvgTracesPerFrame"), Summary.AvgTracesPerFrame, Baseline.AvgTracesPerFrame);
+
+	return bPassed;
+}
@@ -0,0 +1,246 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "XSBenchmarkSubsystem.generated.h"
+
+class AShooterNPC;
+class AShooterNPCSpawner;
+class AXSAbilityCharacter;
+
+/**
+ * Phases of a benchmark run
+ */
+enum class EXSBenchmarkPhase : uint8
+{
+	Idle,
+	Warmup,
+	Measure,
+	Finished
+};
+
+/**
+ * Aggregated results of a benchmark run, also the format of the stored baseline
+ */
+struct FXSBenchmarkSummary
+{
+	/** Measured frames */
+	int32 NumFrames = 0;
+
+	/** Average wall clock frame time */
+	double AvgFrameMs = 0.0;
+
+	/** 95th percentile wall clock frame time */
+	double P95FrameMs = 0.0;
+
+	/** Average game thread time */
+	double AvgGameThreadMs = 0.0;
+
+	/** Peak used physical memory */
+	double PeakUsedPhysicalMB = 0.0;
+
+	/** Average collision traces issued by gameplay code per frame */
+	double AvgTracesPerFrame = 0.0;
+};
+
+/**
+ * Headless combat benchmark
+ * Only created when the game runs with -XSBenchmark. Disables the level's NPC spawners, fills the map
+ * with NPCs acquired from the NPC pool and with ability character bots firing their weapons at them,
+ * then records a fixed-duration CSV capture and writes a summary to Saved/Benchmark.
+ * The process exits with a non-zero code on regression, or when there's no baseline to compare to.
+ *
+ * Command line:
+ *   -XSBenchmarkNPCs=        NPCs kept alive during the run
+ *   -XSBenchmarkBots=        Ability character bots
+ *   -XSBenchmarkWarmup=      Seconds of game time before measuring
+ *   -XSBenchmarkDuration=    Seconds of game time measured
+ *   -XSBenchmarkSeed=        Random seed for placement and gameplay randomness
+ *   -XSBenchmarkBaseline=    Baseline summary to compare against
+ *   -XSBenchmarkBotClasses=  Comma separated bot class paths, replacing the configured ones
+ *   -XSBenchmarkWriteBaseline  Writes the summary to the baseline path instead of comparing
+ *   -XSBenchmarkTolerance=   Allowed relative regression, e.g. 0.1 for 10%
+ *
+ * Run with -benchmark -fps=30 so game time advances in fixed steps and the scenario is repeatable
+ */
+UCLASS(config="Game")
+class PROJECTXS_API UXSBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	// ====== Config ======
+
+	/** Bot classes, assigned round-robin so every weapon fire mode is exercised. Required when bots are requested */
+	UPROPERTY(Config)
+	TArray<TSoftClassPtr<AXSAbilityCharacter>> BotClasses;
+
+	/** Default number of NPCs */
+	UPROPERTY(Config)
+	int32 NumNPCs = 24;
+
+	/** Default number of bots */
+	UPROPERTY(Config)
+	int32 NumBots = 6;
+
+	/** Default warmup time */
+	UPROPERTY(Config)
+	float WarmupTime = 5.0f;
+
+	/** Default measured time */
+	UPROPERTY(Config)
+	float Duration = 60.0f;
+
+	/** Default random seed */
+	UPROPERTY(Config)
+	int32 Seed = 1337;
+
+	/** Default allowed relative regression */
+	UPROPERTY(Config)
+	float Tolerance = 0.1f;
+
+	/** Radius around a spawner used to scatter NPCs and bots */
+	UPROPERTY(Config)
+	float SpawnScatterRadius = 600.0f;
+
+	/** Time between bot fire attempts */
+	UPROPERTY(Config)
+	float BotFireInterval = 0.25f;
+
+	/** Time to wait before replacing a dead NPC */
+	UPROPERTY(Config)
+	float NPCReplaceDelay = 2.0f;
+
+	/** Time between used physical memory samples while measuring */
+	UPROPERTY(Config)
+	float MemorySampleInterval = 0.5f;
+
+	// ====== Runtime ======
+
+	/** Current phase */
+	EXSBenchmarkPhase Phase = EXSBenchmarkPhase::Idle;
+
+	/** Game time the current phase started */
+	double PhaseStartTime = 0.0;
+
+	/** Baseline summary path. Empty to use the default path for the map */
+	FString BaselinePath;
+
+	/** If true, the summary is written as the new baseline instead of being compared */
+	bool bWriteBaseline = false;
+
+	/** Seeded stream for all placement decisions */
+	FRandomStream RandomStream;
+
+	/** NPC spawners found in the level */
+	TArray<TWeakObjectPtr<AShooterNPCSpawner>> Spawners;
+
+	/** NPCs kept alive by the benchmark */
+	TArray<TWeakObjectPtr<AShooterNPC>> NPCs;
+
+	/** Game times at which a dead NPC is replaced */
+	TArray<double> PendingNPCReplacements;
+
+	/** Spawned bots */
+	TArray<TWeakObjectPtr<AXSAbilityCharacter>> Bots;
+
+	/** Game time of the next bot fire attempt */
+	double NextBotFireTime = 0.0;
+
+	/** Wall clock time of the last sampled frame */
+	double LastFrameTime = 0.0;
+
+	/** Sampled wall clock frame times */
+	TArray<float> FrameTimesMs;
+
+	/** Sampled game thread times */
+	TArray<float> GameThreadTimesMs;
+
+	/** Highest used physical memory seen while measuring */
+	uint64 PeakUsedPhysical = 0;
+
+	/** Timer sampling the used physical memory while measuring */
+	FTimerHandle MemorySampleTimer;
+
+	/** Gameplay trace total when measuring started */
+	uint64 TracesIssuedAtMeasureStart = 0;
+
+	/** Gameplay traces issued while measuring */
+	uint64 TracesIssuedWhileMeasuring = 0;
+
+public:
+
+	// ====== Subsystem ======
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Returns true if the game was started with -XSBenchmark */
+	static bool IsBenchmarkRequested();
+
+	/** Returns the current phase */
+	EXSBenchmarkPhase GetPhase() const { return Phase; }
+
+	//~Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return Phase == EXSBenchmarkPhase::Warmup || Phase == EXSBenchmarkPhase::Measure; }
+	virtual TStatId GetStatId() const override;
+	//~End FTickableGameObject interface
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// ====== Scenario ======
+
+	/** Acquires an NPC from the pool near a random spawner */
+	void SpawnNPC();
+
+	/** Spawns a bot of the given class near a random spawner */
+	void SpawnBot(UClass* BotClass);
+
+	/** Returns a scattered, ground-level transform near a random spawner */
+	bool GetRandomSpawnTransform(FTransform& OutTransform);
+
+	/** Replaces NPCs that died */
+	void UpdateNPCs(double Now);
+
+	/** Aims every living bot at the closest NPC and activates its abilities */
+	void FireBots();
+
+	// ====== Measurement ======
+
+	/** Starts the CSV capture and resets the samples */
+	void BeginMeasure();
+
+	/** Records the timings of the last frame */
+	void SampleFrame();
+
+	/** Records the used physical memory */
+	void SampleMemory();
+
+	/** Stops the capture, writes the summary, compares it to the baseline and exits */
+	void FinishBenchmark();
+
+	/** Builds the summary from the recorded samples */
+	FXSBenchmarkSummary BuildSummary() const;
+
+	/** Returns the folder benchmark output is written to */
+	static FString GetOutputDirectory();
+
+	/** Returns the default baseline path for the current map */
+	FString GetDefaultBaselinePath() const;
+
+	/** Writes a summary to a json file */
+	static bool SaveSummary(const FXSBenchmarkSummary& Summary, const FString& Path);
+
+	/** Reads a summary from a json file */
+	static bool LoadSummary(const FString& Path, FXSBenchmarkSummary& OutSummary);
+
+	/** Compares the summary to the baseline and logs every metric. Returns false on regression */
+	bool CompareToBaseline(const FXSBenchmarkSummary& Summary, const FXSBenchmarkSummary& Baseline) const;
+};
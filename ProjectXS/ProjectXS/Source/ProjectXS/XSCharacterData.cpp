@@ -1,3 +1,41 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "XSCharacterData.h"
+#include "XSAbilityCharacter.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Texture2D.h"
+
+const FPrimaryAssetType UXSCharacterData::PrimaryAssetType = TEXT("XSCharacter");
+const FName UXSCharacterData::UIBundle = TEXT("UI");
+const FName UXSCharacterData::MatchBundle = TEXT("Match");
+
+FPrimaryAssetId UXSCharacterData::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+TSharedPtr<FStreamableHandle> UXSCharacterData::LoadRosterUI(FStreamableDelegate OnLoaded)
+{
+	UAssetManager& AssetManager = UAssetManager::Get();
+
+	TArray<FPrimaryAssetId> Roster;
+	AssetManager.GetPrimaryAssetIdList(PrimaryAssetType, Roster);
+
+	// Only the portraits and images are pulled in, character blueprints stay unloaded
+	return AssetManager.LoadPrimaryAssets(Roster, { UIBundle }, MoveTemp(OnLoaded));
+}
+
+TSharedPtr<FStreamableHandle> UXSCharacterData::PreloadMatchCharacters(const TArray<FPrimaryAssetId>& SelectedCharacters, FStreamableDelegate OnLoaded)
+{
+	return UAssetManager::Get().LoadPrimaryAssets(SelectedCharacters, { MatchBundle }, MoveTemp(OnLoaded));
+}
+
+void UXSCharacterData::UnloadCharacterBundle(const TArray<FPrimaryAssetId>& Characters, FName BundleName)
+{
+	UAssetManager::Get().ChangeBundleStateForPrimaryAssets(Characters, TArray<FName>(), { BundleName });
+}
+
+TSubclassOf<AXSAbilityCharacter> UXSCharacterData::GetLoadedCharacterClass() const
+{
+	return CharacterClass.Get();
+}
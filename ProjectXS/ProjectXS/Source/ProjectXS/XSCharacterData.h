@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "Engine/StreamableManager.h"
 #include "XSCharacterData.generated.h"
 
 class AXSAbilityCharacter;
@@ -12,6 +13,8 @@ class UTexture2D;
 /**
  * Character data asset for lobby selection
  * Contains character info, portrait, and stats for display
+ * Heavy references are soft and grouped in asset bundles: the lobby streams the "UI" bundle
+ * for the whole roster, the match preloads the "Match" bundle for the selected characters only
  */
 UCLASS(BlueprintType)
 class PROJECTXS_API UXSCharacterData : public UPrimaryDataAsset
@@ -19,9 +22,45 @@ class PROJECTXS_API UXSCharacterData : public UPrimaryDataAsset
 	GENERATED_BODY()
 
 public:
+	// ====== Asset Bundles ======
+
+	/** Primary asset type shared by every character data asset */
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	/** Bundle with everything the lobby needs to display a character */
+	static const FName UIBundle;
+
+	/** Bundle with everything a match needs to spawn a character */
+	static const FName MatchBundle;
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	/** Async load the UI bundle for every character in the roster */
+	static TSharedPtr<FStreamableHandle> LoadRosterUI(FStreamableDelegate OnLoaded = FStreamableDelegate());
+
+	/** Async load the match bundle for the selected characters only */
+	static TSharedPtr<FStreamableHandle> PreloadMatchCharacters(const TArray<FPrimaryAssetId>& SelectedCharacters, FStreamableDelegate OnLoaded = FStreamableDelegate());
+
+	/** Release a bundle previously loaded for the given characters */
+	static void UnloadCharacterBundle(const TArray<FPrimaryAssetId>& Characters, FName BundleName);
+
+	/** Get the character class if the match bundle is loaded */
+	UFUNCTION(BlueprintPure, Category = "Character")
+	TSubclassOf<AXSAbilityCharacter> GetLoadedCharacterClass() const;
+
+	/** Get the portrait if the UI bundle is loaded */
+	UFUNCTION(BlueprintPure, Category = "Character")
+	UTexture2D* GetLoadedPortrait() const { return CharacterPortrait.Get(); }
+
+	/** Get the full body image if the UI bundle is loaded */
+	UFUNCTION(BlueprintPure, Category = "Character")
+	UTexture2D* GetLoadedFullImage() const { return CharacterFullImage.Get(); }
+
+	// ====== Character Info ======
+
 	/** Character class to spawn in match */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character")
-	TSubclassOf<AXSAbilityCharacter> CharacterClass;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character", meta = (AssetBundles = "Match"))
+	TSoftClassPtr<AXSAbilityCharacter> CharacterClass;
 
 	/** Display name */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character")
@@ -36,12 +75,12 @@ public:
 	FText CharacterDescription;
 
 	/** Portrait image for character selection */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character")
-	UTexture2D* CharacterPortrait;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character", meta = (AssetBundles = "UI"))
+	TSoftObjectPtr<UTexture2D> CharacterPortrait;
 
 	/** Full body image for details view */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character")
-	UTexture2D* CharacterFullImage;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character", meta = (AssetBundles = "UI"))
+	TSoftObjectPtr<UTexture2D> CharacterFullImage;
 
 	/** Character accent color (for UI theming) */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character")
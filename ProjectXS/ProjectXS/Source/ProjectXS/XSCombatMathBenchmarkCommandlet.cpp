@@ -0,0 +1,275 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "XSCombatMathBenchmarkCommandlet.h"
+#include "XSAbility_WeaponFire.h"
+#include "XSAttributeSet.h"
+#include "XSDamageZoneSubsystem.h"
+#include "ShooterWeapon.h"
+#include "ShooterNPC.h"
+#include "ShooterStateTreeUtility.h"
+#include "HAL/MemoryBase.h"
+#include "Misc/FileHelper.h"
+#include "ProjectXS.h"
+#include <atomic>
+
+namespace XSCombatMathBenchmark
+{
+	/** Number of precomputed inputs cycled through by every kernel. Power of two */
+	constexpr int32 NumInputs = 1024;
+
+	/**
+	 * Forwards to the real allocator and counts the game thread calls that allocate
+	 * Installed once for the whole run and never freed, since other threads may still hold it after it's uninstalled.
+	 * Counting is only enabled while a kernel is being timed, and allocations from worker threads are ignored
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+
+		explicit FCountingMalloc(FMalloc* InInnerMalloc)
+			: InnerMalloc(InInnerMalloc)
+		{
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			InnerMalloc->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return InnerMalloc->QuantizeSize(Count, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return InnerMalloc->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return InnerMalloc->IsInternallyThreadSafe();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return TEXT("XSCountingMalloc");
+		}
+
+		/** Resets the counter and starts counting game thread allocations. Game thread only */
+		void StartCounting()
+		{
+			NumAllocations = 0;
+			bCounting.store(true, std::memory_order_relaxed);
+		}
+
+		/** Stops counting and returns the allocations counted since StartCounting. Game thread only */
+		uint64 StopCounting()
+		{
+			bCounting.store(false, std::memory_order_relaxed);
+			return NumAllocations;
+		}
+
+		/** Returns the allocator being forwarded to */
+		FMalloc* GetInnerMalloc() const { return InnerMalloc; }
+
+	private:
+
+		/** Counts an allocating call if it comes from the game thread while counting */
+		void CountAllocation()
+		{
+			if (bCounting.load(std::memory_order_relaxed) && IsInGameThread())
+			{
+				++NumAllocations;
+			}
+		}
+
+		/** Allocator doing the actual work */
+		FMalloc* InnerMalloc;
+
+		/** True while a kernel is being timed */
+		std::atomic<bool> bCounting { false };
+
+		/** Game thread allocating calls since counting started. Only touched by the game thread */
+		uint64 NumAllocations = 0;
+	};
+
+	/** Keeps the compiler from discarding kernel results */
+	volatile float Sink = 0.0f;
+
+	/** Times a kernel. The kernel receives the call index and returns a value folded into the sink */
+	template<typename KernelType>
+	bool RunKernel(const TCHAR* Name, const FString& Filter, int32 Iterations, int32 Repeats, FCountingMalloc& CountingMalloc, KernelType&& Kernel, TArray<FXSKernelBenchmarkResult>& OutResults)
+	{
+		if (!Filter.IsEmpty() && !FCString::Stristr(Name, *Filter))
+		{
+			return false;
+		}
+
+		FXSKernelBenchmarkResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.Name = Name;
+		Result.NanosecondsPerOp = TNumericLimits<double>::Max();
+
+		for (int32 Repeat = 0; Repeat < Repeats; ++Repeat)
+		{
+			CountingMalloc.StartCounting();
+
+			float LocalSink = 0.0f;
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				LocalSink += Kernel(i & (NumInputs - 1));
+			}
+
+			const uint64 EndCycles = FPlatformTime::Cycles64();
+
+			const uint64 NumAllocations = CountingMalloc.StopCounting();
+			Sink = Sink + LocalSink;
+
+			const double NanosecondsPerOp = FPlatformTime::ToSeconds64(EndCycles - StartCycles) * 1.0e9 / Iterations;
+
+			if (NanosecondsPerOp < Result.NanosecondsPerOp)
+			{
+				Result.NanosecondsPerOp = NanosecondsPerOp;
+				Result.AllocationsPerOp = static_cast<double>(NumAllocations) / Iterations;
+			}
+		}
+
+		UE_LOG(LogProjectXS, Display, TEXT("XSCombatMathBenchmark: %-28s %10.2f ns/op %10.4f allocs/op"), Name, Result.NanosecondsPerOp, Result.AllocationsPerOp);
+		return true;
+	}
+}
+
+UXSCombatMathBenchmarkCommandlet::UXSCombatMathBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UXSCombatMathBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace XSCombatMathBenchmark;
+
+	FString CsvPath;
+
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("Repeats="), Repeats);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Filter="), Filter);
+	FParse::Value(*Params, TEXT("Csv="), CsvPath);
+
+	Iterations = FMath::Max(1, Iterations);
+	Repeats = FMath::Max(1, Repeats);
+
+	// Seed the global generator used by the kernels and the stream used for the inputs
+	FMath::RandInit(Seed);
+	FMath::SRandInit(Seed);
+	FRandomStream RandomStream(Seed);
+
+	// Build the inputs up front so only the kernels are timed
+	TArray<FVector> Directions;
+	TArray<FVector> Origins;
+	TArray<FVector> Targets;
+	TArray<float> Scalars;
+
+	Directions.Reserve(NumInputs);
+	Origins.Reserve(NumInputs);
+	Targets.Reserve(NumInputs);
+	Scalars.Reserve(NumInputs);
+
+	for (int32 i = 0; i < NumInputs; ++i)
+	{
+		Directions.Add(RandomStream.GetUnitVector());
+		Origins.Add(RandomStream.GetUnitVector() * RandomStream.FRandRange(0.0f, 5000.0f));
+		Targets.Add(RandomStream.GetUnitVector() * RandomStream.FRandRange(0.0f, 5000.0f));
+		Scalars.Add(RandomStream.FRand());
+	}
+
+	UE_LOG(LogProjectXS, Display, TEXT("XSCombatMathBenchmark: %d iterations, %d repeats, seed %d"), Iterations, Repeats, Seed);
+
+	// Install the counting proxy for the whole run. It's intentionally leaked, see FCountingMalloc
+	FCountingMalloc* CountingMalloc = new FCountingMalloc(GMalloc);
+	GMalloc = CountingMalloc;
+
+	TArray<FXSKernelBenchmarkResult> Results;
+
+	RunKernel(TEXT("SpreadDirection"), Filter, Iterations, Repeats, *CountingMalloc, [&](int32 i)
+	{
+		return UXSAbility_WeaponFire::CalculateSpreadDirection(Directions[i], 2.0f).X;
+	}, Results);
+
+	RunKernel(TEXT("ProjectileSpawnTransform"), Filter, Iterations, Repeats, *CountingMalloc, [&](int32 i)
+	{
+		return static_cast<float>(AShooterWeapon::CalculateProjectileSpawnTransform(Origins[i], Targets[i], 10.0f, 5.0f).GetLocation().X);
+	}, Results);
+
+	RunKernel(TEXT("AreaDamageFalloff"), Filter, Iterations, Repeats, *CountingMalloc, [&](int32 i)
+	{
+		return UXSDamageZoneSubsystem::CalculateFalloffDamage(100.0f, Scalars[i] * 600.0f, 500.0f, true);
+	}, Results);
+
+	RunKernel(TEXT("AttributeMaxChange"), Filter, Iterations, Repeats, *CountingMalloc, [&](int32 i)
+	{
+		return UXSAttributeSet::CalculateMaxChangeDelta(Scalars[i] * 100.0f, 100.0f, 50.0f + Scalars[(i + 1) & (NumInputs - 1)] * 100.0f);
+	}, Results);
+
+	RunKernel(TEXT("NPCAimDirection"), Filter, Iterations, Repeats, *CountingMalloc, [&](int32 i)
+	{
+		return static_cast<float>(AShooterNPC::CalculateAimDirection(Origins[i], Directions[i], (i & 1) == 0, Targets[i], -35.0f, -60.0f, 10.0f).X);
+	}, Results);
+
+	RunKernel(TEXT("LineOfSightFacingCone"), Filter, Iterations, Repeats, *CountingMalloc, [&](int32 i)
+	{
+		return FStateTreeLineOfSightToTargetCondition::IsInFacingCone(Origins[i], Directions[i], Targets[i], 35.0f) ? 1.0f : 0.0f;
+	}, Results);
+
+	// Later allocations go straight to the real allocator again
+	GMalloc = CountingMalloc->GetInnerMalloc();
+
+	if (Results.IsEmpty())
+	{
+		UE_LOG(LogProjectXS, Error, TEXT("XSCombatMathBenchmark: no kernel matches filter %s"), *Filter);
+		return 1;
+	}
+
+	if (!CsvPath.IsEmpty() && !SaveCsv(Results, CsvPath))
+	{
+		return 1;
+	}
+
+	return 0;
+}
+
+bool UXSCombatMathBenchmarkCommandlet::SaveCsv(const TArray<FXSKernelBenchmarkResult>& Results, const FString& Path)
+{
+	FString Output = TEXT("Kernel,NsPerOp,AllocsPerOp\n");
+
+	for (const FXSKernelBenchmarkResult& Result : Results)
+	{
+		Output += FString::Printf(TEXT("%s,%.3f,%.4f\n"), *Result.Name, Result.NanosecondsPerOp, Result.AllocationsPerOp);
+	}
+
+	if (!FFileHelper::SaveStringToFile(Output, *Path))
+	{
+		UE_LOG(LogProjectXS, Error, TEXT("XSCombatMathBenchmark: could not write %s"), *Path);
+		return false;
+	}
+
+	UE_LOG(LogProjectXS, Display, TEXT("XSCombatMathBenchmark: wrote %s"), *Path);
+	return true;
+}
@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "XSCombatMathBenchmarkCommandlet.generated.h"
+
+/**
+ * Result of timing a single combat math kernel
+ */
+struct FXSKernelBenchmarkResult
+{
+	/** Kernel name */
+	FString Name;
+
+	/** Best time per call over all repeats */
+	double NanosecondsPerOp = 0.0;
+
+	/** Allocations per call over the best repeat */
+	double AllocationsPerOp = 0.0;
+};
+
+/**
+ * Microbenchmark for the pure combat math kernels
+ * Runs spread generation, projectile spawn transforms, area damage falloff, attribute max change,
+ * NPC aim cone sampling and the line of sight facing cone in tight loops without a world,
+ * and reports the time and heap allocations per call for each of them.
+ *
+ * Usage: UnrealEditor-Cmd ProjectXS -run=XSCombatMathBenchmark
+ * Optional: -Iterations= -Repeats= -Seed= -Filter=<kernel name substring> -Csv=<output file>
+ */
+UCLASS()
+class PROJECTXS_API UXSCombatMathBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Calls per kernel for each repeat */
+	int32 Iterations = 1000000;
+
+	/** Times each kernel is run. The fastest repeat is reported */
+	int32 Repeats = 5;
+
+	/** Random seed, so every run draws the same inputs and random numbers */
+	int32 Seed = 1337;
+
+	/** Only kernels whose name contains this are run */
+	FString Filter;
+
+public:
+
+	UXSCombatMathBenchmarkCommandlet();
+
+	/** Runs the benchmark */
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+
+	/** Writes the results to a csv file */
+	static bool SaveCsv(const TArray<FXSKernelBenchmarkResult>& Results, const FString& Path);
+};
@@ -0,0 +1,159 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "XSDamageZoneSubsystem.h"
+#include "XSAttributeSet.h"
+#include "AbilitySystemComponent.h"
+#include "GameFramework/Controller.h"
+#include "Kismet/GameplayStatics.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/World.h"
+#include "Components/PrimitiveComponent.h"
+#include "ProjectXSStats.h"
+
+void UXSDamageZoneSubsystem::AddZone(const FXSDamageZone& Zone)
+{
+	// Zones added by damage reactions during a pass are merged once the pass is done
+	FXSDamageZone& NewZone = bIsResolving ? DeferredZones.Add_GetRef(Zone) : Zones.Add_GetRef(Zone);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	NewZone.NextApplyTime = Now + FMath::Max(0.0f, Zone.ActivationDelay);
+	NewZone.ExpireTime = NewZone.NextApplyTime + FMath::Max(0.0f, Zone.Duration);
+}
+
+float UXSDamageZoneSubsystem::CalculateFalloffDamage(float BaseDamage, float Distance, float Radius, bool bUseFalloff)
+{
+	if (!bUseFalloff || Radius <= 0.0f)
+	{
+		return BaseDamage;
+	}
+
+	const float FalloffMultiplier = 1.0f - (Distance / Radius);
+	return BaseDamage * FMath::Max(0.0f, FalloffMultiplier);
+}
+
+TStatId UXSDamageZoneSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UXSDamageZoneSubsystem, STATGROUP_Tickables);
+}
+
+void UXSDamageZoneSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Nothing to resolve if no zone is due this frame
+	const bool bAnyDue = Zones.ContainsByPredicate([Now](const FXSDamageZone& Zone)
+	{
+		return Zone.NextApplyTime <= Now;
+	});
+
+	if (!bAnyDue)
+	{
+		return;
+	}
+
+	bIsResolving = true;
+
+	for (FXSDamageZone& Zone : Zones)
+	{
+		if (Zone.NextApplyTime > Now)
+		{
+			continue;
+		}
+
+		ApplyZone(Zone);
+
+		// Single detonations expire right away, lingering fields schedule their next pass
+		Zone.NextApplyTime = (Zone.Duration > 0.0f && Zone.TickInterval > 0.0f)
+			? Zone.NextApplyTime + Zone.TickInterval
+			: TNumericLimits<double>::Max();
+	}
+
+	bIsResolving = false;
+
+	Zones.RemoveAllSwap([](const FXSDamageZone& Zone)
+	{
+		return Zone.NextApplyTime > Zone.ExpireTime;
+	});
+
+	if (DeferredZones.Num() > 0)
+	{
+		Zones.Append(DeferredZones);
+		DeferredZones.Reset();
+	}
+}
+
+void UXSDamageZoneSubsystem::ApplyZone(const FXSDamageZone& Zone)
+{
+	// Overlap against the actual collision on the pawn channel, so large pawns are hit by their shape and not their center
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(XSDamageZone), false);
+
+	if (const AActor* ZoneInstigator = Zone.Instigator.Get())
+	{
+		QueryParams.AddIgnoredActor(ZoneInstigator);
+	}
+
+	OverlapResults.Reset();
+	GetWorld()->OverlapMultiByChannel(OverlapResults, Zone.Location, FQuat::Identity, ECC_Pawn, FCollisionShape::MakeSphere(Zone.Radius), QueryParams);
+
+	// Actors overlapping with several components are damaged once, at the distance of their closest component bounds
+	OverlapDistances.Reset();
+
+	for (const FOverlapResult& Overlap : OverlapResults)
+	{
+		AActor* HitActor = Overlap.GetActor();
+		const UPrimitiveComponent* HitComponent = Overlap.GetComponent();
+
+		if (!IsValid(HitActor) || !HitComponent)
+		{
+			continue;
+		}
+
+		const float Distance = FMath::Sqrt(HitComponent->Bounds.GetBox().ComputeSquaredDistanceToPoint(Zone.Location));
+
+		float& ClosestDistance = OverlapDistances.FindOrAdd(HitActor, Distance);
+		ClosestDistance = FMath::Min(ClosestDistance, Distance);
+	}
+
+	for (const TPair<AActor*, float>& OverlapDistance : OverlapDistances)
+	{
+		// Damage reactions can destroy actors further down the list
+		if (!IsValid(OverlapDistance.Key))
+		{
+			continue;
+		}
+
+		const float FinalDamage = CalculateFalloffDamage(Zone.Damage, OverlapDistance.Value, Zone.Radius, Zone.bUseFalloff);
+
+		if (FinalDamage > 0.0f)
+		{
+			ApplyDamageToActor(OverlapDistance.Key, FinalDamage, Zone);
+		}
+	}
+
+	// Debug visualization
+	#if !UE_BUILD_SHIPPING && !UE_SERVER
+	DrawDebugSphere(GetWorld(), Zone.Location, Zone.Radius, 32, FColor::Orange, false, 2.0f, 0, 2.0f);
+	#endif
+}
+
+void UXSDamageZoneSubsystem::ApplyDamageToActor(AActor* HitActor, float FinalDamage, const FXSDamageZone& Zone) const
+{
+	XS_SCOPE_CYCLE_COUNTER(STAT_XS_ApplyDamage);
+	XS_INC_COUNTER(STAT_XS_DamageEvents, 1);
+
+	if (UAbilitySystemComponent* TargetASC = HitActor->FindComponentByClass<UAbilitySystemComponent>())
+	{
+		// Apply damage through GAS
+		if (const UXSAttributeSet* TargetAttributes = TargetASC->GetSet<UXSAttributeSet>())
+		{
+			TargetASC->ApplyModToAttribute(TargetAttributes->GetDamageAttribute(), EGameplayModOp::Additive, FinalDamage);
+		}
+	}
+	else
+	{
+		// Fallback to standard damage
+		UGameplayStatics::ApplyDamage(HitActor, FinalDamage, Zone.InstigatorController.Get(), Zone.Instigator.Get(), nullptr);
+	}
+}
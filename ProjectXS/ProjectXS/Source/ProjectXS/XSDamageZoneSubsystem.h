@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/OverlapResult.h"
+#include "XSDamageZoneSubsystem.generated.h"
+
+class AActor;
+class AController;
+
+/**
+ * A pending or lingering area of damage
+ * Delayed detonations use a zero duration, damage fields keep ticking until they expire
+ */
+USTRUCT()
+struct PROJECTXS_API FXSDamageZone
+{
+	GENERATED_BODY()
+
+	/** Center of the damage area */
+	FVector Location = FVector::ZeroVector;
+
+	/** Radius of the damage area */
+	float Radius = 500.0f;
+
+	/** Damage dealt at the center of the area on each application */
+	float Damage = 100.0f;
+
+	/** Whether damage falls off with distance from center */
+	bool bUseFalloff = true;
+
+	/** Time before the first damage application */
+	float ActivationDelay = 0.0f;
+
+	/** How long the area keeps dealing damage after the first application. Zero for a single detonation */
+	float Duration = 0.0f;
+
+	/** Time between damage applications while the area lingers */
+	float TickInterval = 0.5f;
+
+	/** Actor that created the zone. Never damaged by its own zone */
+	TWeakObjectPtr<AActor> Instigator;
+
+	/** Controller credited with the damage */
+	TWeakObjectPtr<AController> InstigatorController;
+
+	/** World time of the next damage application */
+	double NextApplyTime = 0.0;
+
+	/** World time after which the zone is removed */
+	double ExpireTime = 0.0;
+};
+
+/**
+ * World-level manager for all area damage zones
+ * Owns delayed detonations and damage-over-time fields in a single array and resolves
+ * every zone that is due in one pass per tick, each with a sphere overlap on the pawn channel
+ */
+UCLASS()
+class PROJECTXS_API UXSDamageZoneSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Registers a new damage zone. Damage is resolved by the next batched pass once the zone is due */
+	void AddZone(const FXSDamageZone& Zone);
+
+	/** Returns the number of zones waiting to detonate or still lingering */
+	int32 GetNumActiveZones() const { return Zones.Num(); }
+
+	/** Returns the damage dealt at the given distance from the zone center */
+	static float CalculateFalloffDamage(float BaseDamage, float Distance, float Radius, bool bUseFalloff);
+
+	//~Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return Zones.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	//~End FTickableGameObject interface
+
+protected:
+
+	/** Applies one damage pass of the given zone to every actor overlapping it */
+	void ApplyZone(const FXSDamageZone& Zone);
+
+	/** Applies damage to a single actor through GAS, falling back to standard damage */
+	void ApplyDamageToActor(AActor* HitActor, float FinalDamage, const FXSDamageZone& Zone) const;
+
+	/** All active zones */
+	TArray<FXSDamageZone> Zones;
+
+	/** Zones registered while a pass was being resolved */
+	TArray<FXSDamageZone> DeferredZones;
+
+	/** True while zones are being resolved */
+	bool bIsResolving = false;
+
+	/** Overlaps of the zone being applied */
+	TArray<FOverlapResult> OverlapResults;
+
+	/** Closest overlap distance per actor hit by the zone being applied */
+	TMap<AActor*, float> OverlapDistances;
+};
@@ -0,0 +1,284 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "XSFireLatencySubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "GameFramework/Actor.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProjectXSStats.h"
+#include "ProjectXS.h"
+
+CSV_DEFINE_CATEGORY(XSLatency, true);
+
+namespace XSFireLatency
+{
+	/** Stage names, used for CSV columns and the summary log */
+	const TCHAR* StageNames[] =
+	{
+		TEXT("InputToActivate"),
+		TEXT("InputToHit"),
+		TEXT("InputToHealth"),
+		TEXT("ServerActivateToHit"),
+		TEXT("ServerActivateToDamage"),
+	};
+
+	static_assert(UE_ARRAY_COUNT(StageNames) == static_cast<uint8>(EXSFireLatencyStage::Num), "Missing fire latency stage name");
+}
+
+// ====== Histogram ======
+
+void FXSLatencyHistogram::AddSample(float Milliseconds)
+{
+	if (Buckets.IsEmpty())
+	{
+		Buckets.SetNumZeroed(NumBuckets);
+	}
+
+	const int32 Bucket = FMath::Clamp(FMath::FloorToInt(Milliseconds / BucketWidthMs), 0, NumBuckets - 1);
+
+	++Buckets[Bucket];
+	++NumSamples;
+}
+
+float FXSLatencyHistogram::GetPercentile(float Percentile) const
+{
+	if (NumSamples == 0)
+	{
+		return 0.0f;
+	}
+
+	// Rank of the sample holding the percentile, 1 based
+	const uint32 Rank = FMath::Max<uint32>(1, FMath::CeilToInt(Percentile * NumSamples));
+	uint32 Count = 0;
+
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		Count += Buckets[Bucket];
+
+		if (Count >= Rank)
+		{
+			return (Bucket + 1) * BucketWidthMs;
+		}
+	}
+
+	return NumBuckets * BucketWidthMs;
+}
+
+// ====== Subsystem ======
+
+bool UXSFireLatencySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+	return false;
+#else
+	return Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+void UXSFireLatencySubsystem::Deinitialize()
+{
+	for (uint8 Stage = 0; Stage < static_cast<uint8>(EXSFireLatencyStage::Num); ++Stage)
+	{
+		const FXSLatencyHistogram& Histogram = Histograms[Stage];
+
+		if (Histogram.NumSamples > 0)
+		{
+			UE_LOG(LogProjectXS, Log, TEXT("XSFireLatency: %-24s %6u samples  p50 %6.1fms  p95 %6.1fms  p99 %6.1fms"),
+				XSFireLatency::StageNames[Stage], Histogram.NumSamples,
+				Histogram.GetPercentile(0.5f), Histogram.GetPercentile(0.95f), Histogram.GetPercentile(0.99f));
+		}
+	}
+
+	Events.Empty();
+	PendingInputs.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UXSFireLatencySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UXSFireLatencySubsystem, STATGROUP_Tickables);
+}
+
+void UXSFireLatencySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	ExpireEvents(FPlatformTime::Seconds());
+
+	if (bStatsDirty)
+	{
+		bStatsDirty = false;
+		PublishStats();
+	}
+}
+
+// ====== Pipeline Stages ======
+
+void UXSFireLatencySubsystem::MarkFireInput(UAbilitySystemComponent* ASC)
+{
+	if (ASC)
+	{
+		PendingInputs.Add(ASC, FPlatformTime::Seconds());
+	}
+}
+
+void UXSFireLatencySubsystem::ClearFireInput(UAbilitySystemComponent* ASC)
+{
+	// Local activations happen while the input is handled, so an input still pending never activated
+	PendingInputs.Remove(ASC);
+}
+
+void UXSFireLatencySubsystem::MarkActivation(UAbilitySystemComponent* ASC, int16 PredictionKey, bool bIsLocallyControlled, bool bHasAuthority)
+{
+	if (!ASC)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const uint64 Key = MakeEventKey(ASC, PredictionKey);
+
+	FXSFireLatencyEvent& Event = Events.Add(Key);
+	Event.CreateTime = Now;
+
+	// Claim the input that triggered this activation. Held automatic fire reactivates without new input
+	double InputTime = 0.0;
+	if (bIsLocallyControlled && PendingInputs.RemoveAndCopyValue(ASC, InputTime))
+	{
+		Event.InputTime = InputTime;
+		AddSample(EXSFireLatencyStage::InputToActivate, InputTime, Now);
+	}
+
+	if (bHasAuthority)
+	{
+		Event.ServerActivateTime = Now;
+	}
+}
+
+void UXSFireLatencySubsystem::MarkHit(UAbilitySystemComponent* ASC, int16 PredictionKey, AActor* HitActor, bool bIsLocallyControlled, bool bHasAuthority)
+{
+	FXSFireLatencyEvent* Event = ASC ? Events.Find(MakeEventKey(ASC, PredictionKey)) : nullptr;
+	if (!Event)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	if (bIsLocallyControlled && Event->InputTime > 0.0)
+	{
+		AddSample(EXSFireLatencyStage::InputToHit, Event->InputTime, Now);
+
+		// Remote clients wait for the hit actor's health to come back from the server
+		if (HitActor && !bHasAuthority)
+		{
+			Event->HitActor = HitActor;
+		}
+	}
+
+	if (bHasAuthority && Event->ServerActivateTime > 0.0)
+	{
+		AddSample(EXSFireLatencyStage::ServerActivateToHit, Event->ServerActivateTime, Now);
+	}
+}
+
+void UXSFireLatencySubsystem::MarkDamageApplied(UAbilitySystemComponent* ASC, int16 PredictionKey)
+{
+	const FXSFireLatencyEvent* Event = ASC ? Events.Find(MakeEventKey(ASC, PredictionKey)) : nullptr;
+
+	if (Event && Event->ServerActivateTime > 0.0)
+	{
+		AddSample(EXSFireLatencyStage::ServerActivateToDamage, Event->ServerActivateTime, FPlatformTime::Seconds());
+	}
+}
+
+void UXSFireLatencySubsystem::MarkHealthReplicated(AActor* DamagedActor)
+{
+	if (!DamagedActor)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	// Only a handful of shots are ever in flight, a linear search is fine
+	for (TPair<uint64, FXSFireLatencyEvent>& Pair : Events)
+	{
+		FXSFireLatencyEvent& Event = Pair.Value;
+
+		if (Event.HitActor.Get() == DamagedActor)
+		{
+			AddSample(EXSFireLatencyStage::InputToHealth, Event.InputTime, Now);
+			Event.HitActor.Reset();
+		}
+	}
+}
+
+// ====== Internals ======
+
+uint64 UXSFireLatencySubsystem::MakeEventKey(const UAbilitySystemComponent* ASC, int16 PredictionKey)
+{
+	return (static_cast<uint64>(ASC->GetUniqueID()) << 16) | static_cast<uint16>(PredictionKey);
+}
+
+void UXSFireLatencySubsystem::AddSample(EXSFireLatencyStage Stage, double StartTime, double EndTime)
+{
+	const float Milliseconds = static_cast<float>((EndTime - StartTime) * 1000.0);
+
+	Histograms[static_cast<uint8>(Stage)].AddSample(Milliseconds);
+	bStatsDirty = true;
+
+#if CSV_PROFILER
+	// Raw samples, so captures can be histogrammed offline
+	FCsvProfiler::RecordCustomStat(XSFireLatency::StageNames[static_cast<uint8>(Stage)], CSV_CATEGORY_INDEX(XSLatency), Milliseconds, ECsvCustomStatOp::Max);
+#endif
+}
+
+void UXSFireLatencySubsystem::PublishStats()
+{
+	const FXSLatencyHistogram& InputToActivate = GetHistogram(EXSFireLatencyStage::InputToActivate);
+	const FXSLatencyHistogram& InputToHit = GetHistogram(EXSFireLatencyStage::InputToHit);
+	const FXSLatencyHistogram& InputToHealth = GetHistogram(EXSFireLatencyStage::InputToHealth);
+	const FXSLatencyHistogram& ServerActivateToHit = GetHistogram(EXSFireLatencyStage::ServerActivateToHit);
+	const FXSLatencyHistogram& ServerActivateToDamage = GetHistogram(EXSFireLatencyStage::ServerActivateToDamage);
+
+	SET_FLOAT_STAT(STAT_XS_Latency_InputToActivate_P50, InputToActivate.GetPercentile(0.5f));
+	SET_FLOAT_STAT(STAT_XS_Latency_InputToActivate_P95, InputToActivate.GetPercentile(0.95f));
+	SET_FLOAT_STAT(STAT_XS_Latency_InputToActivate_P99, InputToActivate.GetPercentile(0.99f));
+	SET_FLOAT_STAT(STAT_XS_Latency_InputToHit_P50, InputToHit.GetPercentile(0.5f));
+	SET_FLOAT_STAT(STAT_XS_Latency_InputToHit_P95, InputToHit.GetPercentile(0.95f));
+	SET_FLOAT_STAT(STAT_XS_Latency_InputToHit_P99, InputToHit.GetPercentile(0.99f));
+	SET_FLOAT_STAT(STAT_XS_Latency_InputToHealth_P50, InputToHealth.GetPercentile(0.5f));
+	SET_FLOAT_STAT(STAT_XS_Latency_InputToHealth_P95, InputToHealth.GetPercentile(0.95f));
+	SET_FLOAT_STAT(STAT_XS_Latency_InputToHealth_P99, InputToHealth.GetPercentile(0.99f));
+	SET_FLOAT_STAT(STAT_XS_Latency_ServerActivateToHit_P50, ServerActivateToHit.GetPercentile(0.5f));
+	SET_FLOAT_STAT(STAT_XS_Latency_ServerActivateToHit_P95, ServerActivateToHit.GetPercentile(0.95f));
+	SET_FLOAT_STAT(STAT_XS_Latency_ServerActivateToHit_P99, ServerActivateToHit.GetPercentile(0.99f));
+	SET_FLOAT_STAT(STAT_XS_Latency_ServerActivateToDamage_P50, ServerActivateToDamage.GetPercentile(0.5f));
+	SET_FLOAT_STAT(STAT_XS_Latency_ServerActivateToDamage_P95, ServerActivateToDamage.GetPercentile(0.95f));
+	SET_FLOAT_STAT(STAT_XS_Latency_ServerActivateToDamage_P99, ServerActivateToDamage.GetPercentile(0.99f));
+
+#if CSV_PROFILER
+	// Running percentiles, the last frame of a capture holds the run's totals
+	for (uint8 Stage = 0; Stage < static_cast<uint8>(EXSFireLatencyStage::Num); ++Stage)
+	{
+		const FXSLatencyHistogram& Histogram = Histograms[Stage];
+		const FString StageName = XSFireLatency::StageNames[Stage];
+
+		FCsvProfiler::RecordCustomStat(*(StageName + TEXT("_P50")), CSV_CATEGORY_INDEX(XSLatency), Histogram.GetPercentile(0.5f), ECsvCustomStatOp::Set);
+		FCsvProfiler::RecordCustomStat(*(StageName + TEXT("_P95")), CSV_CATEGORY_INDEX(XSLatency), Histogram.GetPercentile(0.95f), ECsvCustomStatOp::Set);
+		FCsvProfiler::RecordCustomStat(*(StageName + TEXT("_P99")), CSV_CATEGORY_INDEX(XSLatency), Histogram.GetPercentile(0.99f), ECsvCustomStatOp::Set);
+	}
+#endif
+}
+
+void UXSFireLatencySubsystem::ExpireEvents(double Now)
+{
+	for (auto It = Events.CreateIterator(); It; ++It)
+	{
+		if (Now - It->Value.CreateTime >= EventLifetime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,159 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "XSFireLatencySubsystem.generated.h"
+
+class AActor;
+class UAbilitySystemComponent;
+
+/**
+ * Measured intervals of the weapon fire pipeline
+ * Client intervals start at the fire input, server intervals at the server activation,
+ * since the two ends run in different processes with unrelated clocks
+ */
+enum class EXSFireLatencyStage : uint8
+{
+	/** Fire input to local ability activation */
+	InputToActivate,
+
+	/** Fire input to local hitscan resolution */
+	InputToHit,
+
+	/** Fire input to the replicated health of the hit actor arriving back on the client */
+	InputToHealth,
+
+	/** Server activation to server hitscan resolution */
+	ServerActivateToHit,
+
+	/** Server activation to damage applied to the target's attributes */
+	ServerActivateToDamage,
+
+	Num
+};
+
+/**
+ * Fixed bucket latency histogram
+ */
+struct FXSLatencyHistogram
+{
+	/** Width of a bucket, in milliseconds */
+	static constexpr float BucketWidthMs = 0.5f;
+
+	/** Number of buckets. Samples above the last bucket are clamped into it */
+	static constexpr int32 NumBuckets = 1000;
+
+	/** Sample count per bucket */
+	TArray<uint32> Buckets;
+
+	/** Total samples */
+	uint32 NumSamples = 0;
+
+	/** Adds a sample */
+	void AddSample(float Milliseconds);
+
+	/** Returns the upper bound of the bucket holding the given percentile, 0 to 1 */
+	float GetPercentile(float Percentile) const;
+};
+
+/**
+ * A single shot moving through the fire pipeline
+ */
+struct FXSFireLatencyEvent
+{
+	/** Platform time the event was created, used to expire it */
+	double CreateTime = 0.0;
+
+	/** Platform time of the fire input. Zero if not fired by local input */
+	double InputTime = 0.0;
+
+	/** Platform time of the server activation. Zero on clients */
+	double ServerActivateTime = 0.0;
+
+	/** Actor hit by the local hitscan, waiting for its health to replicate */
+	TWeakObjectPtr<AActor> HitActor;
+};
+
+/**
+ * Measures the latency of the weapon fire pipeline
+ * Shots are stitched together by their ability system component and activation prediction key,
+ * from the fire input through local activation, hitscan and damage, to the hit actor's health
+ * replicating back to the shooting client. Each interval is kept in a histogram whose
+ * p50/p95/p99 are published to the XSLatency stat group and to CSV captures.
+ * Not available in shipping builds.
+ */
+UCLASS()
+class PROJECTXS_API UXSFireLatencySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Shots in flight, by ability system component and prediction key */
+	TMap<uint64, FXSFireLatencyEvent> Events;
+
+	/** Fire input time waiting to be claimed by the activation it triggers, by ability system component */
+	TMap<TObjectKey<UAbilitySystemComponent>, double> PendingInputs;
+
+	/** Histograms by stage */
+	FXSLatencyHistogram Histograms[static_cast<uint8>(EXSFireLatencyStage::Num)];
+
+	/** True when the histograms changed since the stats were published */
+	bool bStatsDirty = false;
+
+	/** Seconds after which an incomplete shot is dropped */
+	static constexpr double EventLifetime = 2.0;
+
+public:
+
+	// ====== Subsystem ======
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+
+	// ====== Pipeline Stages ======
+
+	/** Fire input pressed on the owning client */
+	void MarkFireInput(UAbilitySystemComponent* ASC);
+
+	/** Fire input handled. Drops the input if it failed to activate the ability */
+	void ClearFireInput(UAbilitySystemComponent* ASC);
+
+	/** Fire ability activated. Local and authority activations are both recorded on listen servers and standalone */
+	void MarkActivation(UAbilitySystemComponent* ASC, int16 PredictionKey, bool bIsLocallyControlled, bool bHasAuthority);
+
+	/** Hitscan resolved */
+	void MarkHit(UAbilitySystemComponent* ASC, int16 PredictionKey, AActor* HitActor, bool bIsLocallyControlled, bool bHasAuthority);
+
+	/** Damage applied on the server by the given shot */
+	void MarkDamageApplied(UAbilitySystemComponent* ASC, int16 PredictionKey);
+
+	/** Replicated health arrived for the given actor */
+	void MarkHealthReplicated(AActor* DamagedActor);
+
+	/** Returns the histogram for a stage */
+	const FXSLatencyHistogram& GetHistogram(EXSFireLatencyStage Stage) const { return Histograms[static_cast<uint8>(Stage)]; }
+
+	//~Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return bStatsDirty || Events.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	//~End FTickableGameObject interface
+
+protected:
+
+	/** Returns the key for a shot */
+	static uint64 MakeEventKey(const UAbilitySystemComponent* ASC, int16 PredictionKey);
+
+	/** Adds a sample to a stage */
+	void AddSample(EXSFireLatencyStage Stage, double StartTime, double EndTime);
+
+	/** Publishes the percentiles to stats and CSV */
+	void PublishStats();
+
+	/** Drops shots that were never completed */
+	void ExpireEvents(double Now);
+};
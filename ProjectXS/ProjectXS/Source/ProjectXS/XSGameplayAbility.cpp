@@ -6,6 +6,7 @@
 #include "XSAttributeSet.h"
 #include "AbilitySystemComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "ProjectXSStats.h"
 
 UXSGameplayAbility::UXSGameplayAbility()
 {
@@ -62,6 +63,8 @@ void UXSGameplayAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle
 {
 	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 
+	XS_INC_COUNTER(STAT_XS_AbilitiesActivated, 1);
+
 	// Consume energy on activation
 	if (HasAuthority(&ActivationInfo))
 	{
@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "XSResourceMeterComponent.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+UXSResourceMeterComponent::UXSResourceMeterComponent()
+{
+	// Evaluated on read, never ticks
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UXSResourceMeterComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(ThresholdTimer);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UXSResourceMeterComponent::InitializeMeter(float InMaxValue, float InValue)
+{
+	MaxValue = FMath::Max(InMaxValue, 0.0f);
+	Rate = 0.0f;
+
+	SetValue(InValue);
+}
+
+void UXSResourceMeterComponent::SetValue(float InValue)
+{
+	BaseValue = FMath::Clamp(InValue, 0.0f, MaxValue);
+	BaseTime = GetNow();
+
+	ScheduleThreshold();
+
+	OnMeterChanged.Broadcast(BaseValue, Rate);
+}
+
+void UXSResourceMeterComponent::SetRate(float InRate)
+{
+	if (InRate == Rate)
+	{
+		return;
+	}
+
+	Rebase();
+	Rate = InRate;
+
+	ScheduleThreshold();
+
+	OnMeterChanged.Broadcast(BaseValue, Rate);
+}
+
+float UXSResourceMeterComponent::GetValue() const
+{
+	if (Rate == 0.0f)
+	{
+		return BaseValue;
+	}
+
+	return FMath::Clamp(BaseValue + Rate * static_cast<float>(GetNow() - BaseTime), 0.0f, MaxValue);
+}
+
+float UXSResourceMeterComponent::GetPercent() const
+{
+	return MaxValue > 0.0f ? GetValue() / MaxValue : 0.0f;
+}
+
+double UXSResourceMeterComponent::GetNow() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+void UXSResourceMeterComponent::Rebase()
+{
+	BaseValue = GetValue();
+	BaseTime = GetNow();
+}
+
+void UXSResourceMeterComponent::ScheduleThreshold()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	FTimerManager& TimerManager = World->GetTimerManager();
+	TimerManager.ClearTimer(ThresholdTimer);
+
+	// Time until the meter hits the threshold it is moving towards
+	float TimeToThreshold = -1.0f;
+
+	if (Rate < 0.0f && BaseValue > 0.0f)
+	{
+		TimeToThreshold = BaseValue / -Rate;
+	}
+	else if (Rate > 0.0f && BaseValue < MaxValue)
+	{
+		TimeToThreshold = (MaxValue - BaseValue) / Rate;
+	}
+
+	if (TimeToThreshold > 0.0f)
+	{
+		TimerManager.SetTimer(ThresholdTimer, this, &UXSResourceMeterComponent::OnThresholdReached, TimeToThreshold, false);
+	}
+	else
+	{
+		// Already at the threshold it is moving towards, the value can't change
+		Rate = 0.0f;
+	}
+}
+
+void UXSResourceMeterComponent::OnThresholdReached()
+{
+	// Snap to the threshold to avoid float drift
+	const bool bEmptied = Rate < 0.0f;
+
+	BaseValue = bEmptied ? 0.0f : MaxValue;
+	BaseTime = GetNow();
+	Rate = 0.0f;
+
+	OnMeterChanged.Broadcast(BaseValue, Rate);
+
+	if (bEmptied)
+	{
+		OnMeterEmptied.Broadcast(this);
+	}
+	else
+	{
+		OnMeterFilled.Broadcast(this);
+	}
+}
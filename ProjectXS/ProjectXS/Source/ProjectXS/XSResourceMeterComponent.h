@@ -0,0 +1,109 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/TimerHandle.h"
+#include "XSResourceMeterComponent.generated.h"
+
+class UXSResourceMeterComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FXSResourceMeterDelegate, UXSResourceMeterComponent*, Meter);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FXSResourceMeterChangedDelegate, float, Value, float, Rate);
+
+/**
+ * Resource meter that fills and drains at a constant rate without ticking
+ * Stores the value at the last change together with the rate and the time of the change,
+ * and evaluates the current value when read. A single timer is scheduled for the next
+ * time the meter runs empty or full. Events fire only when the value is set, the rate
+ * changes or a threshold is reached, so an idle meter costs nothing.
+ * Used for sprint stamina, and suitable for any linear resource such as energy.
+ */
+UCLASS(ClassGroup = "Gameplay", meta = (BlueprintSpawnableComponent))
+class PROJECTXS_API UXSResourceMeterComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UXSResourceMeterComponent();
+
+	// ====== Events ======
+
+	/** Value was set or the rate changed. Interpolate between events with GetValue */
+	UPROPERTY(BlueprintAssignable, Category = "Meter")
+	FXSResourceMeterChangedDelegate OnMeterChanged;
+
+	/** Meter drained to zero. The rate is reset to zero before this fires */
+	UPROPERTY(BlueprintAssignable, Category = "Meter")
+	FXSResourceMeterDelegate OnMeterEmptied;
+
+	/** Meter filled to its max. The rate is reset to zero before this fires */
+	UPROPERTY(BlueprintAssignable, Category = "Meter")
+	FXSResourceMeterDelegate OnMeterFilled;
+
+	// ====== Methods ======
+
+	/** Sets the max and current value and stops the meter */
+	UFUNCTION(BlueprintCallable, Category = "Meter")
+	void InitializeMeter(float InMaxValue, float InValue);
+
+	/** Sets the current value, keeping the rate */
+	UFUNCTION(BlueprintCallable, Category = "Meter")
+	void SetValue(float InValue);
+
+	/** Sets the fill rate in units per second. Negative rates drain the meter */
+	UFUNCTION(BlueprintCallable, Category = "Meter")
+	void SetRate(float InRate);
+
+	/** Returns the current value */
+	UFUNCTION(BlueprintPure, Category = "Meter")
+	float GetValue() const;
+
+	/** Returns the current value as a fraction of the max */
+	UFUNCTION(BlueprintPure, Category = "Meter")
+	float GetPercent() const;
+
+	/** Returns the fill rate in units per second */
+	UFUNCTION(BlueprintPure, Category = "Meter")
+	float GetRate() const { return Rate; }
+
+	/** Returns the max value */
+	UFUNCTION(BlueprintPure, Category = "Meter")
+	float GetMaxValue() const { return MaxValue; }
+
+	/** Returns true while the meter is filling or draining */
+	UFUNCTION(BlueprintPure, Category = "Meter")
+	bool IsChanging() const { return Rate != 0.0f; }
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Max value */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Meter", meta = (ClampMin = 0))
+	float MaxValue = 1.0f;
+
+	/** Value at BaseTime */
+	float BaseValue = 1.0f;
+
+	/** Fill rate in units per second */
+	float Rate = 0.0f;
+
+	/** World time BaseValue was taken at */
+	double BaseTime = 0.0;
+
+	/** Fires when the meter next runs empty or full */
+	FTimerHandle ThresholdTimer;
+
+	/** Returns the world time */
+	double GetNow() const;
+
+	/** Folds the elapsed time into BaseValue */
+	void Rebase();
+
+	/** Schedules the threshold timer for the current rate */
+	void ScheduleThreshold();
+
+	/** Called when the meter runs empty or full */
+	void OnThresholdReached();
+};
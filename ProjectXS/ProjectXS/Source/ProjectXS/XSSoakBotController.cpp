@@ -0,0 +1,234 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "XSSoakBotController.h"
+#include "XSAbilityCharacter.h"
+#include "XSWeaponBase.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Misc/CommandLine.h"
+
+void AXSSoakBotController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Each client is launched with its own seed so the bots spread out
+	int32 Seed = 0;
+	FParse::Value(FCommandLine::Get(), TEXT("XSSoakSeed="), Seed);
+	RandomStream.Initialize(Seed);
+}
+
+void AXSSoakBotController::PlayerTick(float DeltaTime)
+{
+	Super::PlayerTick(DeltaTime);
+
+	APawn* ControlledPawn = GetPawn();
+
+	if (!IsLocalController() || !ControlledPawn)
+	{
+		return;
+	}
+
+	// Pick a new home whenever we get a new pawn
+	if (HomePawn.Get() != ControlledPawn)
+	{
+		ResetHome(ControlledPawn);
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	UpdateMovement(Now);
+	UpdateAim();
+	UpdateActions(Now);
+	UpdateCorrections();
+}
+
+void AXSSoakBotController::ResetHome(APawn* InPawn)
+{
+	HomePawn = InPawn;
+	HomeLocation = InPawn->GetActorLocation();
+	WanderLocation = HomeLocation;
+	NextWanderTime = 0.0;
+	LastCorrectionTime = 0.0f;
+}
+
+void AXSSoakBotController::UpdateMovement(double Now)
+{
+	APawn* ControlledPawn = GetPawn();
+	const FVector PawnLocation = ControlledPawn->GetActorLocation();
+
+	// Pick a new wander location when the current one is reached or taking too long
+	if (Now >= NextWanderTime || FVector::Dist2D(PawnLocation, WanderLocation) < AcceptanceRadius)
+	{
+		NextWanderTime = Now + WanderInterval;
+
+		const FVector2D Offset = FVector2D(RandomStream.FRandRange(-1.0f, 1.0f), RandomStream.FRandRange(-1.0f, 1.0f)) * WanderRadius;
+		WanderLocation = HomeLocation + FVector(Offset, 0.0f);
+
+		if (ACharacter* ControlledCharacter = Cast<ACharacter>(ControlledPawn))
+		{
+			if (RandomStream.FRand() < JumpChance)
+			{
+				ControlledCharacter->Jump();
+			}
+		}
+	}
+
+	// Feed movement input like a player would, so the move goes through client prediction
+	const FVector MoveDir = (WanderLocation - PawnLocation).GetSafeNormal2D();
+	ControlledPawn->AddMovementInput(MoveDir);
+}
+
+void AXSSoakBotController::UpdateAim()
+{
+	const APawn* ControlledPawn = GetPawn();
+	const FVector ViewLocation = ControlledPawn->GetPawnViewLocation();
+
+	const APawn* Target = nullptr;
+	double BestDistSquared = TNumericLimits<double>::Max();
+
+	for (TActorIterator<APawn> It(GetWorld()); It; ++It)
+	{
+		if (*It == ControlledPawn)
+		{
+			continue;
+		}
+
+		const double DistSquared = FVector::DistSquared(ViewLocation, It->GetActorLocation());
+		if (DistSquared < BestDistSquared)
+		{
+			BestDistSquared = DistSquared;
+			Target = *It;
+		}
+	}
+
+	// Nobody else around, look where we're going
+	const FVector AimTarget = Target ? Target->GetActorLocation() : WanderLocation;
+	SetControlRotation((AimTarget - ViewLocation).Rotation());
+}
+
+void AXSSoakBotController::UpdateActions(double Now)
+{
+	// Release the held input first
+	if (HeldAction != EXSSoakBotAction::Num && Now >= ReleaseTime)
+	{
+		ReleaseAction(HeldAction);
+		HeldAction = EXSSoakBotAction::Num;
+	}
+
+	if (Now < NextActionTime)
+	{
+		return;
+	}
+
+	NextActionTime = Now + ActionInterval;
+
+	if (HeldAction != EXSSoakBotAction::Num)
+	{
+		ReleaseAction(HeldAction);
+	}
+
+	// Reload right away when the magazine is empty, otherwise cycle through every input
+	EXSSoakBotAction Action = static_cast<EXSSoakBotAction>(NextAction);
+
+	const AXSAbilityCharacter* XSCharacter = Cast<AXSAbilityCharacter>(GetPawn());
+	const AXSWeaponBase* Weapon = XSCharacter ? XSCharacter->GetCurrentWeapon() : nullptr;
+
+	if (Weapon && Weapon->CurrentAmmo <= 0)
+	{
+		Action = EXSSoakBotAction::Reload;
+	}
+	else
+	{
+		NextAction = (NextAction + 1) % static_cast<uint8>(EXSSoakBotAction::Num);
+	}
+
+	PressAction(Action);
+
+	HeldAction = Action;
+	ReleaseTime = Now + ActionHoldTime;
+}
+
+void AXSSoakBotController::UpdateCorrections()
+{
+	const ACharacter* ControlledCharacter = Cast<ACharacter>(GetPawn());
+	UCharacterMovementComponent* Movement = ControlledCharacter ? ControlledCharacter->GetCharacterMovement() : nullptr;
+
+	// Only autonomous proxies receive corrections
+	if (!Movement || ControlledCharacter->GetLocalRole() != ROLE_AutonomousProxy)
+	{
+		return;
+	}
+
+	const FNetworkPredictionData_Client_Character* ClientData = Movement->GetPredictionData_Client_Character();
+
+	if (ClientData && ClientData->LastCorrectionTime != LastCorrectionTime)
+	{
+		LastCorrectionTime = ClientData->LastCorrectionTime;
+		++NumCorrections;
+	}
+}
+
+void AXSSoakBotController::PressAction(EXSSoakBotAction Action)
+{
+	switch (Action)
+	{
+	case EXSSoakBotAction::Fire:
+		OnFirePressed();
+		break;
+
+	case EXSSoakBotAction::AltFire:
+		OnAltFirePressed();
+		break;
+
+	case EXSSoakBotAction::Ability1:
+		OnAbility1Pressed();
+		break;
+
+	case EXSSoakBotAction::Ability2:
+		OnAbility2Pressed();
+		break;
+
+	case EXSSoakBotAction::Ultimate:
+		OnUltimatePressed();
+		break;
+
+	case EXSSoakBotAction::Reload:
+		OnReloadPressed();
+		break;
+
+	default:
+		break;
+	}
+}
+
+void AXSSoakBotController::ReleaseAction(EXSSoakBotAction Action)
+{
+	switch (Action)
+	{
+	case EXSSoakBotAction::Fire:
+		OnFireReleased();
+		break;
+
+	case EXSSoakBotAction::AltFire:
+		OnAltFireReleased();
+		break;
+
+	case EXSSoakBotAction::Ability1:
+		OnAbility1Released();
+		break;
+
+	case EXSSoakBotAction::Ability2:
+		OnAbility2Released();
+		break;
+
+	case EXSSoakBotAction::Ultimate:
+		OnUltimateReleased();
+		break;
+
+	default:
+		// reload has no release
+		break;
+	}
+}
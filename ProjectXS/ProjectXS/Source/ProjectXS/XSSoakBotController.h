@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProjectXSPlayerController.h"
+#include "XSSoakBotController.generated.h"
+
+/**
+ * Input steps cycled by the soak bot
+ */
+enum class EXSSoakBotAction : uint8
+{
+	Fire,
+	AltFire,
+	Ability1,
+	Ability2,
+	Ultimate,
+	Reload,
+	Num
+};
+
+/**
+ * Player controller that plays the game by itself for network soak tests
+ * Runs on the owning client, so movement goes through client prediction and abilities
+ * are activated through the same ability input IDs as a human player.
+ * Wanders around its spawn location, turns towards the closest other pawn, cycles through
+ * fire, alt fire, abilities, ultimate and reload, and counts the movement corrections
+ * received from the server.
+ */
+UCLASS(config="Game")
+class PROJECTXS_API AXSSoakBotController : public AProjectXSPlayerController
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Max distance from the spawn location to wander to */
+	UPROPERTY(Config)
+	float WanderRadius = 1500.0f;
+
+	/** Time spent walking towards a wander location before picking a new one */
+	UPROPERTY(Config)
+	float WanderInterval = 3.0f;
+
+	/** Distance at which a wander location counts as reached */
+	UPROPERTY(Config)
+	float AcceptanceRadius = 100.0f;
+
+	/** Time between input steps */
+	UPROPERTY(Config)
+	float ActionInterval = 0.3f;
+
+	/** Time an input is held before being released */
+	UPROPERTY(Config)
+	float ActionHoldTime = 0.15f;
+
+	/** Chance to jump every time a new wander location is picked */
+	UPROPERTY(Config)
+	float JumpChance = 0.2f;
+
+	/** Seeded stream for the bot's decisions */
+	FRandomStream RandomStream;
+
+	/** Pawn the home location was picked for */
+	TWeakObjectPtr<APawn> HomePawn;
+
+	/** Location the bot wanders around */
+	FVector HomeLocation = FVector::ZeroVector;
+
+	/** Location the bot is walking towards */
+	FVector WanderLocation = FVector::ZeroVector;
+
+	/** Game time a new wander location is picked */
+	double NextWanderTime = 0.0;
+
+	/** Game time of the next input step */
+	double NextActionTime = 0.0;
+
+	/** Game time the held input is released */
+	double ReleaseTime = 0.0;
+
+	/** Input currently held */
+	EXSSoakBotAction HeldAction = EXSSoakBotAction::Num;
+
+	/** Next input step */
+	uint8 NextAction = 0;
+
+	/** Last correction timestamp seen on the movement component */
+	float LastCorrectionTime = 0.0f;
+
+	/** Movement corrections received from the server */
+	int32 NumCorrections = 0;
+
+public:
+
+	/** Gameplay initialization */
+	virtual void BeginPlay() override;
+
+	/** Drives the bot on the owning client */
+	virtual void PlayerTick(float DeltaTime) override;
+
+	/** Returns the movement corrections received from the server */
+	int32 GetNumCorrections() const { return NumCorrections; }
+
+protected:
+
+	/** Resets the wander state around the pawn's location */
+	void ResetHome(APawn* InPawn);
+
+	/** Walks towards the wander location */
+	void UpdateMovement(double Now);
+
+	/** Turns towards the closest other pawn */
+	void UpdateAim();
+
+	/** Presses and releases the ability inputs */
+	void UpdateActions(double Now);
+
+	/** Counts new corrections from the server */
+	void UpdateCorrections();
+
+	/** Presses the input for an action */
+	void PressAction(EXSSoakBotAction Action);
+
+	/** Releases the input for an action */
+	void ReleaseAction(EXSSoakBotAction Action);
+};
@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "XSSoakGameMode.h"
+#include "XSSoakBotController.h"
+#include "XSAbilityCharacter.h"
+#include "Misc/CommandLine.h"
+#include "ProjectXS.h"
+
+AXSSoakGameMode::AXSSoakGameMode()
+{
+	PlayerControllerClass = AXSSoakBotController::StaticClass();
+}
+
+void AXSSoakGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	FString PawnClassPath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("XSSoakPawn="), PawnClassPath))
+	{
+		SoakPawnClass = TSoftClassPtr<AXSAbilityCharacter>(FSoftObjectPath(PawnClassPath));
+	}
+
+	if (UClass* PawnClass = SoakPawnClass.LoadSynchronous())
+	{
+		DefaultPawnClass = PawnClass;
+	}
+	else
+	{
+		UE_LOG(LogProjectXS, Warning, TEXT("XSSoak: no soak pawn class configured, bots use %s"), *GetNameSafe(DefaultPawnClass));
+	}
+}
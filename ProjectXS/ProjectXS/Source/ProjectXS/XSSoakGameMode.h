@@ -0,0 +1,34 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProjectXSGameMode.h"
+#include "XSSoakGameMode.generated.h"
+
+class AXSAbilityCharacter;
+
+/**
+ *  Game mode for network soak tests
+ *  Every player gets a soak bot controller and an ability character.
+ *  Select it on the server map URL with ?game=/Script/ProjectXS.XSSoakGameMode
+ */
+UCLASS(config="Game")
+class PROJECTXS_API AXSSoakGameMode : public AProjectXSGameMode
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Character spawned for every bot. Overridden with -XSSoakPawn=<class path> */
+	UPROPERTY(Config)
+	TSoftClassPtr<AXSAbilityCharacter> SoakPawnClass;
+
+public:
+
+	/** Constructor */
+	AXSSoakGameMode();
+
+	/** Resolves the pawn class */
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+};
@@ -0,0 +1,214 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "XSSoakRecorderSubsystem.h"
+#include "XSSoakBotController.h"
+#include "Engine/World.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetConnection.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProjectXS.h"
+
+bool UXSSoakRecorderSubsystem::IsSoakRequested()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("XSSoak"));
+}
+
+bool UXSSoakRecorderSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && IsSoakRequested();
+}
+
+bool UXSSoakRecorderSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game;
+}
+
+void UXSSoakRecorderSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FParse::Value(FCommandLine::Get(), TEXT("XSSoakDuration="), Duration);
+	Duration = FMath::Max(1.0f, Duration);
+}
+
+void UXSSoakRecorderSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Clients start in an entry world until they connect, only record the networked world
+	if (InWorld.GetNetMode() == NM_Standalone)
+	{
+		return;
+	}
+
+	bRecording = true;
+	StartTime = InWorld.GetTimeSeconds();
+	NextSampleTime = StartTime + SampleInterval;
+	LastFrameTime = FPlatformTime::Seconds();
+
+#if CSV_PROFILER
+	const FString CsvName = FString::Printf(TEXT("%s_%u.csv"), *GetRoleName(), FPlatformProcess::GetCurrentProcessId());
+	FCsvProfiler::Get()->BeginCapture(-1, FPaths::ProjectSavedDir() / TEXT("Soak"), CsvName);
+#endif
+
+	UE_LOG(LogProjectXS, Log, TEXT("XSSoak: recording %s for %.0fs"), *GetRoleName(), Duration);
+}
+
+TStatId UXSSoakRecorderSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UXSSoakRecorderSubsystem, STATGROUP_Tickables);
+}
+
+void UXSSoakRecorderSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double FrameTime = FPlatformTime::Seconds();
+
+	FrameTimesMs.Add(static_cast<float>((FrameTime - LastFrameTime) * 1000.0));
+	GameThreadTimesMs.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+
+	LastFrameTime = FrameTime;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	if (Now >= NextSampleTime)
+	{
+		NextSampleTime = Now + SampleInterval;
+		SampleConnections();
+	}
+
+	if (Now - StartTime >= Duration)
+	{
+		FinishRecording();
+	}
+}
+
+void UXSSoakRecorderSubsystem::SampleConnections()
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!NetDriver)
+	{
+		return;
+	}
+
+	if (NetDriver->ServerConnection)
+	{
+		SampleConnection(NetDriver->ServerConnection, TEXT("Server"));
+	}
+
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (Connection)
+		{
+			SampleConnection(Connection, Connection->LowLevelGetRemoteAddress(true));
+		}
+	}
+}
+
+void UXSSoakRecorderSubsystem::SampleConnection(UNetConnection* Connection, const FString& Name)
+{
+	FXSSoakConnectionStats& Stats = ConnectionStats.FindOrAdd(Name);
+
+	++Stats.NumSamples;
+	Stats.InBytesPerSecondSum += Connection->InBytesPerSecond;
+	Stats.OutBytesPerSecondSum += Connection->OutBytesPerSecond;
+	Stats.PeakInBytesPerSecond = FMath::Max(Stats.PeakInBytesPerSecond, Connection->InBytesPerSecond);
+	Stats.PeakOutBytesPerSecond = FMath::Max(Stats.PeakOutBytesPerSecond, Connection->OutBytesPerSecond);
+	Stats.OutLossPercentageSum += Connection->GetOutLossPercentage().GetAvgLossPercentage();
+}
+
+void UXSSoakRecorderSubsystem::FinishRecording()
+{
+	bRecording = false;
+
+#if CSV_PROFILER
+	FCsvProfiler::Get()->EndCapture();
+#endif
+
+	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetStringField(TEXT("Role"), GetRoleName());
+	JsonObject->SetNumberField(TEXT("DurationSeconds"), Duration);
+
+	// Tick times
+	if (FrameTimesMs.Num() > 0)
+	{
+		double FrameSum = 0.0;
+		double GameThreadSum = 0.0;
+
+		for (int32 i = 0; i < FrameTimesMs.Num(); ++i)
+		{
+			FrameSum += FrameTimesMs[i];
+			GameThreadSum += GameThreadTimesMs[i];
+		}
+
+		TArray<float> SortedFrameTimes = FrameTimesMs;
+		SortedFrameTimes.Sort();
+
+		JsonObject->SetNumberField(TEXT("NumFrames"), FrameTimesMs.Num());
+		JsonObject->SetNumberField(TEXT("AvgTickMs"), FrameSum / FrameTimesMs.Num());
+		JsonObject->SetNumberField(TEXT("P95TickMs"), SortedFrameTimes[FMath::Min(SortedFrameTimes.Num() - 1, FMath::FloorToInt(SortedFrameTimes.Num() * 0.95f))]);
+		JsonObject->SetNumberField(TEXT("AvgGameThreadMs"), GameThreadSum / FrameTimesMs.Num());
+	}
+
+	// Bandwidth per connection
+	TArray<TSharedPtr<FJsonValue>> ConnectionValues;
+
+	for (const TPair<FString, FXSSoakConnectionStats>& Pair : ConnectionStats)
+	{
+		const FXSSoakConnectionStats& Stats = Pair.Value;
+		const double NumSamples = FMath::Max(1, Stats.NumSamples);
+
+		TSharedRef<FJsonObject> ConnectionObject = MakeShared<FJsonObject>();
+		ConnectionObject->SetStringField(TEXT("Name"), Pair.Key);
+		ConnectionObject->SetNumberField(TEXT("AvgInBytesPerSecond"), Stats.InBytesPerSecondSum / NumSamples);
+		ConnectionObject->SetNumberField(TEXT("AvgOutBytesPerSecond"), Stats.OutBytesPerSecondSum / NumSamples);
+		ConnectionObject->SetNumberField(TEXT("PeakInBytesPerSecond"), Stats.PeakInBytesPerSecond);
+		ConnectionObject->SetNumberField(TEXT("PeakOutBytesPerSecond"), Stats.PeakOutBytesPerSecond);
+		ConnectionObject->SetNumberField(TEXT("AvgOutLossPercentage"), Stats.OutLossPercentageSum / NumSamples);
+
+		ConnectionValues.Add(MakeShared<FJsonValueObject>(ConnectionObject));
+	}
+
+	JsonObject->SetArrayField(TEXT("Connections"), ConnectionValues);
+
+	// Movement corrections received by this client's bot
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		JsonObject->SetNumberField(TEXT("Corrections"), GetLocalCorrections());
+	}
+
+	FString Output;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(JsonObject, Writer);
+
+	const FString Path = FPaths::ProjectSavedDir() / TEXT("Soak") / FString::Printf(TEXT("%s_%u.json"), *GetRoleName(), FPlatformProcess::GetCurrentProcessId());
+
+	if (FFileHelper::SaveStringToFile(Output, *Path))
+	{
+		UE_LOG(LogProjectXS, Display, TEXT("XSSoak: wrote %s"), *Path);
+	}
+	else
+	{
+		UE_LOG(LogProjectXS, Error, TEXT("XSSoak: failed to write %s"), *Path);
+	}
+
+	FPlatformMisc::RequestExit(false);
+}
+
+int32 UXSSoakRecorderSubsystem::GetLocalCorrections() const
+{
+	const AXSSoakBotController* BotController = Cast<AXSSoakBotController>(GetWorld()->GetFirstPlayerController());
+	return BotController ? BotController->GetNumCorrections() : 0;
+}
+
+FString UXSSoakRecorderSubsystem::GetRoleName() const
+{
+	return GetWorld()->GetNetMode() == NM_Client ? TEXT("Client") : TEXT("Server");
+}
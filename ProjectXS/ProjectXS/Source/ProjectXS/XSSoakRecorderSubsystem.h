@@ -0,0 +1,115 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "XSSoakRecorderSubsystem.generated.h"
+
+class UNetConnection;
+
+/**
+ * Bandwidth samples for a single net connection
+ */
+struct FXSSoakConnectionStats
+{
+	/** Number of samples taken */
+	int32 NumSamples = 0;
+
+	/** Sum of incoming bytes per second over all samples */
+	double InBytesPerSecondSum = 0.0;
+
+	/** Sum of outgoing bytes per second over all samples */
+	double OutBytesPerSecondSum = 0.0;
+
+	/** Highest incoming bytes per second */
+	int32 PeakInBytesPerSecond = 0;
+
+	/** Highest outgoing bytes per second */
+	int32 PeakOutBytesPerSecond = 0;
+
+	/** Sum of outgoing packet loss percentages over all samples */
+	double OutLossPercentageSum = 0.0;
+};
+
+/**
+ * Records a network soak run on the server and on every client
+ * Only created when the process runs with -XSSoak. Samples tick times every frame and the
+ * bandwidth of every net connection every second, captures a CSV profile, and after
+ * -XSSoakDuration= seconds writes a summary to Saved/Soak and exits.
+ * Clients also record the movement corrections their soak bot received.
+ * Per actor class replication cost is recorded by the Networking Insights trace started
+ * by the soak script.
+ */
+UCLASS(config="Game")
+class PROJECTXS_API UXSSoakRecorderSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Default run time in seconds */
+	UPROPERTY(Config)
+	float Duration = 300.0f;
+
+	/** Time between bandwidth samples */
+	UPROPERTY(Config)
+	float SampleInterval = 1.0f;
+
+	/** True while recording */
+	bool bRecording = false;
+
+	/** Game time recording started */
+	double StartTime = 0.0;
+
+	/** Game time of the next bandwidth sample */
+	double NextSampleTime = 0.0;
+
+	/** Wall clock time of the last sampled frame */
+	double LastFrameTime = 0.0;
+
+	/** Sampled wall clock frame times */
+	TArray<float> FrameTimesMs;
+
+	/** Sampled game thread times */
+	TArray<float> GameThreadTimesMs;
+
+	/** Bandwidth samples by remote address */
+	TMap<FString, FXSSoakConnectionStats> ConnectionStats;
+
+public:
+
+	// ====== Subsystem ======
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Returns true if the process was started with -XSSoak */
+	static bool IsSoakRequested();
+
+	//~Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return bRecording; }
+	virtual TStatId GetStatId() const override;
+	//~End FTickableGameObject interface
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Samples the bandwidth of every open connection */
+	void SampleConnections();
+
+	/** Samples a single connection */
+	void SampleConnection(UNetConnection* Connection, const FString& Name);
+
+	/** Stops the capture, writes the summary and exits */
+	void FinishRecording();
+
+	/** Returns the movement corrections received by the local soak bot */
+	int32 GetLocalCorrections() const;
+
+	/** Returns "Server" or "Client" */
+	FString GetRoleName() const;
+};
@@ -2,6 +2,8 @@
 
 #include "XSWeaponBase.h"
 #include "ProjectXSCharacter.h"
+#include "AbilitySystemGlobals.h"
+#include "GameplayCueManager.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "TimerManager.h"
@@ -9,7 +11,10 @@
 
 AXSWeaponBase::AXSWeaponBase()
 {
-	PrimaryActorTick.bCanEverTick = false;
+	// Only ticks to flush the effect batch, after everything that can fire this frame
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
 	bReplicates = true;
 	bNetUseOwnerRelevancy = true;
 
@@ -44,6 +49,11 @@ AXSWeaponBase::AXSWeaponBase()
 
 	MuzzleSocketName = FName("Muzzle");
 
+	FireCueTag = FGameplayTag::RequestGameplayTag(FName("GameplayCue.Weapon.Fire"));
+	ImpactCueTag = FGameplayTag::RequestGameplayTag(FName("GameplayCue.Weapon.Impact"));
+	MaxBatchedImpacts = 16;
+	bEffectFlushPending = false;
+
 	OwningCharacter = nullptr;
 }
 
@@ -56,6 +66,13 @@ void AXSWeaponBase::BeginPlay()
 	ReserveAmmo = MaxReserveAmmo;
 }
 
+void AXSWeaponBase::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	FlushEffectBatch();
+}
+
 void AXSWeaponBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -124,7 +141,11 @@ void AXSWeaponBase::StartReload()
 		GetWorldTimerManager().SetTimer(ReloadTimerHandle, this, &AXSWeaponBase::FinishReload, ReloadTime, false);
 	}
 
-	PlayReloadEffects();
+	// Reload effects are purely cosmetic
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		PlayReloadEffects();
+	}
 }
 
 void AXSWeaponBase::FinishReload()
@@ -177,6 +198,128 @@ FTransform AXSWeaponBase::GetMuzzleTransform() const
 	return GetActorTransform();
 }
 
+void AXSWeaponBase::AddPendingFire(const FVector& MuzzleLocation, const FVector& TraceEnd)
+{
+	PendingEffects.MuzzleLocation = MuzzleLocation;
+	PendingEffects.TraceEnd = TraceEnd;
+	PendingEffects.ShotCount = FMath::Min<int32>(PendingEffects.ShotCount + 1, MAX_uint8);
+
+	ScheduleEffectFlush();
+}
+
+void AXSWeaponBase::AddPendingImpact(const FVector& Location, const FVector& Normal)
+{
+	if (PendingEffects.Impacts.Num() >= MaxBatchedImpacts)
+	{
+		return;
+	}
+
+	FXSWeaponImpact& Impact = PendingEffects.Impacts.AddDefaulted_GetRef();
+	Impact.Location = Location;
+	Impact.Normal = Normal;
+
+	ScheduleEffectFlush();
+}
+
+void AXSWeaponBase::ScheduleEffectFlush()
+{
+	if (bEffectFlushPending)
+	{
+		return;
+	}
+
+	// Enabled mid-frame, the tick still runs in this frame's post update work group
+	bEffectFlushPending = true;
+	SetActorTickEnabled(true);
+}
+
+void AXSWeaponBase::FlushEffectBatch()
+{
+	bEffectFlushPending = false;
+	SetActorTickEnabled(false);
+
+	if (PendingEffects.ShotCount == 0 && PendingEffects.Impacts.Num() == 0)
+	{
+		return;
+	}
+
+	if (HasAuthority())
+	{
+		// One packet for the whole frame. The multicast also runs here for listen servers
+		MulticastPlayEffectBatch(PendingEffects);
+	}
+	else if (IsOwnerLocallyControlled())
+	{
+		// Predicting client plays its own shots immediately
+		PlayEffectBatch(PendingEffects);
+	}
+
+	PendingEffects.ShotCount = 0;
+	PendingEffects.Impacts.Reset();
+}
+
+void AXSWeaponBase::MulticastPlayEffectBatch_Implementation(const FXSWeaponEffectBatch& Batch)
+{
+	// The owning client already played these effects when it predicted the shots
+	if (!HasAuthority() && IsOwnerLocallyControlled())
+	{
+		return;
+	}
+
+	// Nobody to show effects to on a dedicated server
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	PlayEffectBatch(Batch);
+}
+
+void AXSWeaponBase::PlayEffectBatch(const FXSWeaponEffectBatch& Batch)
+{
+	UGameplayCueManager* CueManager = UAbilitySystemGlobals::Get().GetGameplayCueManager();
+	AActor* CueTarget = GetOwner() ? GetOwner() : this;
+
+	if (CueManager)
+	{
+		FGameplayCueParameters CueParams;
+		CueParams.Instigator = GetOwner();
+		CueParams.EffectCauser = this;
+		CueParams.SourceObject = this;
+
+		if (Batch.ShotCount > 0 && FireCueTag.IsValid())
+		{
+			CueParams.Location = Batch.MuzzleLocation;
+			CueParams.Normal = (Batch.TraceEnd - Batch.MuzzleLocation).GetSafeNormal();
+			CueParams.RawMagnitude = Batch.ShotCount;
+			CueManager->HandleGameplayCue(CueTarget, FireCueTag, EGameplayCueEvent::Executed, CueParams);
+		}
+
+		if (ImpactCueTag.IsValid())
+		{
+			CueParams.RawMagnitude = Batch.Impacts.Num();
+
+			for (const FXSWeaponImpact& Impact : Batch.Impacts)
+			{
+				CueParams.Location = Impact.Location;
+				CueParams.Normal = Impact.Normal;
+				CueManager->HandleGameplayCue(CueTarget, ImpactCueTag, EGameplayCueEvent::Executed, CueParams);
+			}
+		}
+	}
+
+	if (Batch.ShotCount > 0)
+	{
+		PlayFireEffects(Batch.MuzzleLocation, Batch.TraceEnd);
+	}
+}
+
+bool AXSWeaponBase::IsOwnerLocallyControlled() const
+{
+	const APawn* OwnerPawn = Cast<APawn>(GetOwner());
+	return OwnerPawn && OwnerPawn->IsLocallyControlled();
+}
+
 void AXSWeaponBase::PlayFireEffects_Implementation(const FVector& MuzzleLocation, const FVector& HitLocation)
 {
 	// Override in Blueprint or subclasses to add muzzle flash, sounds, etc.
@@ -185,7 +328,8 @@ void AXSWeaponBase::PlayFireEffects_Implementation(const FVector& MuzzleLocation
 void AXSWeaponBase::PlayReloadEffects_Implementation()
 {
 	// Override in Blueprint or subclasses to add reload sounds, animations, etc.
-	
+
+#if !UE_SERVER
 	// Play reload animation on character if available
 	if (OwningCharacter)
 	{
@@ -205,6 +349,7 @@ void AXSWeaponBase::PlayReloadEffects_Implementation()
 			}
 		}
 	}
+#endif
 }
 
 void AXSWeaponBase::OnRep_CurrentAmmo()
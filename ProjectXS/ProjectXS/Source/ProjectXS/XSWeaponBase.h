@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "GameplayTagContainer.h"
+#include "Engine/NetSerialization.h"
 #include "XSWeaponBase.generated.h"
 
 class AProjectXSCharacter;
@@ -20,6 +21,47 @@ enum class EXSWeaponFireMode : uint8
 	Beam		UMETA(DisplayName = "Beam")
 };
 
+/**
+ * Single impact in a batched weapon effect payload
+ */
+USTRUCT()
+struct FXSWeaponImpact
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector_NetQuantize Location;
+
+	UPROPERTY()
+	FVector_NetQuantizeNormal Normal;
+};
+
+/**
+ * All fire and impact effects produced by one weapon in one frame
+ * Sent to simulated proxies as a single unreliable multicast
+ */
+USTRUCT()
+struct FXSWeaponEffectBatch
+{
+	GENERATED_BODY()
+
+	/** Muzzle location of the last shot in the batch */
+	UPROPERTY()
+	FVector_NetQuantize MuzzleLocation;
+
+	/** Trace end of the last shot in the batch */
+	UPROPERTY()
+	FVector_NetQuantize TraceEnd;
+
+	/** Number of shots fired this frame */
+	UPROPERTY()
+	uint8 ShotCount = 0;
+
+	/** Impacts produced this frame */
+	UPROPERTY()
+	TArray<FXSWeaponImpact> Impacts;
+};
+
 /**
  * Base weapon class for all character weapons
  * Weapons are tied to characters and grant abilities through the GAS
@@ -136,6 +178,20 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|Animation")
 	UAnimMontage* ReloadAnimation3P;
 
+	// ====== Effects ======
+
+	/** GameplayCue executed once per batched fire event */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|Effects", meta = (Categories = "GameplayCue"))
+	FGameplayTag FireCueTag;
+
+	/** GameplayCue executed for each impact in a batch */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|Effects", meta = (Categories = "GameplayCue"))
+	FGameplayTag ImpactCueTag;
+
+	/** Max impacts packed into a single effect batch. Extra impacts in the same frame are dropped */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|Effects", meta = (ClampMin = 1, ClampMax = 255))
+	int32 MaxBatchedImpacts;
+
 	// ====== Methods ======
 
 	/** Attach weapon to character */
@@ -174,7 +230,13 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Weapon")
 	FTransform GetMuzzleTransform() const;
 
-	/** Play fire effects */
+	/** Queue a shot for this frame's effect batch */
+	void AddPendingFire(const FVector& MuzzleLocation, const FVector& TraceEnd);
+
+	/** Queue an impact for this frame's effect batch */
+	void AddPendingImpact(const FVector& Location, const FVector& Normal);
+
+	/** Play fire effects. Called once per effect batch, after the fire cue */
 	UFUNCTION(BlueprintNativeEvent, Category = "Weapon")
 	void PlayFireEffects(const FVector& MuzzleLocation, const FVector& HitLocation);
 
@@ -184,6 +246,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void Tick(float DeltaTime) override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	/** Owning character reference */
@@ -197,6 +260,28 @@ protected:
 	/** Timer handle for reload */
 	FTimerHandle ReloadTimerHandle;
 
+	/** Effects queued this frame */
+	FXSWeaponEffectBatch PendingEffects;
+
+	/** True if a flush of the pending effects is already scheduled */
+	bool bEffectFlushPending;
+
+	/** Schedules the pending effects to be flushed by this frame's post update tick */
+	void ScheduleEffectFlush();
+
+	/** Plays the pending effects locally and forwards them to simulated proxies */
+	void FlushEffectBatch();
+
+	/** Sends a batch of effects to everyone but the predicting owner */
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastPlayEffectBatch(const FXSWeaponEffectBatch& Batch);
+
+	/** Executes the fire and impact cues for a batch */
+	void PlayEffectBatch(const FXSWeaponEffectBatch& Batch);
+
+	/** Returns true if the owning pawn is controlled on this machine */
+	bool IsOwnerLocallyControlled() const;
+
 	UFUNCTION()
 	void OnRep_CurrentAmmo();
 